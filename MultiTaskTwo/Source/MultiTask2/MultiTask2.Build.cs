@@ -21,7 +21,8 @@ public class MultiTask2 : ModuleRules
                 "ProceduralMeshComponent",
                 "GeometryCore",
                 "DynamicMesh",
-                "GeometryAlgorithms"
+                "GeometryAlgorithms",
+                "DeveloperSettings"
                 // ... add other public dependencies that you statically link with here ...
             }
         );
@@ -5,8 +5,13 @@
 #include "MultiFrameLoop1DTask.h"
 #include "MultiFrameLoop2DTask.h"
 #include "MultiFrameLoop3DTask.h"
+#include "MultiFrameLoopBatchTask.h"
+#include "MultiFrameParallelLoopTask.h"
+#include "MultiFrameSparseLoopTask.h"
+#include "MultiFrameTaskScheduler.h"
+#include "MultiTask2.h"
 
-void UMultiFrameTaskLibrary::DoAsyncTask(UObject* WorldContextObject, EMultiTask2BranchesNoCompleteWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameAsyncTask> Class, UMultiFrameAsyncTask*& Task, int32 IterationsPerTick, float Delay)
+void UMultiFrameTaskLibrary::DoAsyncTask(UObject* WorldContextObject, EMultiTask2BranchesNoCompleteWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameAsyncTask> Class, UMultiFrameAsyncTask*& Task, int32 IterationsPerTick, float Delay, float TimeBudget)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -32,6 +37,12 @@ void UMultiFrameTaskLibrary::DoAsyncTask(UObject* WorldContextObject, EMultiTask
 		return;
 	}
 
+	if (TimeBudget < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoAsyncTask: TimeBudget can't be lower than 0."), ELogVerbosity::Error);
+		return;
+	}
+
 	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
@@ -43,13 +54,13 @@ void UMultiFrameTaskLibrary::DoAsyncTask(UObject* WorldContextObject, EMultiTask
 			return;
 		}
 		else {
-			Action = new FMultiFrameAsyncTaskAction(WorldContextObject, Out, LatentInfo, Class, IterationsPerTick, Delay, Task);
+			Action = new FMultiFrameAsyncTaskAction(WorldContextObject, Out, LatentInfo, Class, IterationsPerTick, Delay, TimeBudget, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
 }
 
-void UMultiFrameTaskLibrary::DoLoop1DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop1DTask> Class, int32& X, UMultiFrameLoop1DTask*& Task, int32 XSize, int32 IterationsPerTick, float Delay)
+void UMultiFrameTaskLibrary::DoLoop1DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop1DTask> Class, int32& X, UMultiFrameLoop1DTask*& Task, int32 XSize, int32 IterationsPerTick, float Delay, float TimeBudget)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -81,6 +92,12 @@ void UMultiFrameTaskLibrary::DoLoop1DTask(UObject* WorldContextObject, EMultiTas
 		return;
 	}
 
+	if (TimeBudget < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoop1DTask: TimeBudget can't be lower than 0."), ELogVerbosity::Error);
+		return;
+	}
+
 	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
@@ -92,13 +109,13 @@ void UMultiFrameTaskLibrary::DoLoop1DTask(UObject* WorldContextObject, EMultiTas
 			return;
 		}
 		else {
-			Action = new FMultiFrameLoop1DTaskAction(WorldContextObject, Out, LatentInfo, Class, X, XSize, IterationsPerTick, Delay, Task);
+			Action = new FMultiFrameLoop1DTaskAction(WorldContextObject, Out, LatentInfo, Class, X, XSize, IterationsPerTick, Delay, TimeBudget, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
 }
 
-void UMultiFrameTaskLibrary::DoLoop2DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop2DTask> Class, int32& X, int32& Y, UMultiFrameLoop2DTask*& Task, int32 XSize, int32 YSize, int32 IterationsPerTick, float Delay)
+void UMultiFrameTaskLibrary::DoLoop2DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop2DTask> Class, int32& X, int32& Y, UMultiFrameLoop2DTask*& Task, int32 XSize, int32 YSize, int32 IterationsPerTick, float Delay, float TimeBudget, EMultiFrameLoopOrder IterationOrder, int32 TileSize)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -136,6 +153,18 @@ void UMultiFrameTaskLibrary::DoLoop2DTask(UObject* WorldContextObject, EMultiTas
 		return;
 	}
 
+	if (TimeBudget < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoop2DTask: TimeBudget can't be lower than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (TileSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoop2DTask: Tile Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
 	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
@@ -147,13 +176,13 @@ void UMultiFrameTaskLibrary::DoLoop2DTask(UObject* WorldContextObject, EMultiTas
 			return;
 		}
 		else {
-			Action = new FMultiFrameLoop2DTaskAction(WorldContextObject, Out, LatentInfo, Class, X, Y, XSize, YSize, IterationsPerTick, Delay, Task);
+			Action = new FMultiFrameLoop2DTaskAction(WorldContextObject, Out, LatentInfo, Class, X, Y, XSize, YSize, IterationsPerTick, Delay, TimeBudget, IterationOrder, TileSize, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
 }
 
-void UMultiFrameTaskLibrary::DoLoop3DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop3DTask> Class, int32& X, int32& Y, int32& Z, UMultiFrameLoop3DTask*& Task, int32 XSize, int32 YSize, int32 ZSize, int32 IterationsPerTick, float Delay)
+void UMultiFrameTaskLibrary::DoLoop3DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop3DTask> Class, int32& X, int32& Y, int32& Z, UMultiFrameLoop3DTask*& Task, int32 XSize, int32 YSize, int32 ZSize, int32 IterationsPerTick, float Delay, float TimeBudget, EMultiFrameLoopOrder IterationOrder, int32 TileSize)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -197,6 +226,18 @@ void UMultiFrameTaskLibrary::DoLoop3DTask(UObject* WorldContextObject, EMultiTas
 		return;
 	}
 
+	if (TimeBudget < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoop3DTask: TimeBudget can't be lower than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (TileSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoop3DTask: Tile Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
 	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
 	{
 		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
@@ -208,8 +249,232 @@ void UMultiFrameTaskLibrary::DoLoop3DTask(UObject* WorldContextObject, EMultiTas
 			return;
 		}
 		else {
-			Action = new FMultiFrameLoop3DTaskAction(WorldContextObject, Out, LatentInfo, Class, X, Y, Z, XSize, YSize, ZSize, IterationsPerTick, Delay, Task);
+			Action = new FMultiFrameLoop3DTaskAction(WorldContextObject, Out, LatentInfo, Class, X, Y, Z, XSize, YSize, ZSize, IterationsPerTick, Delay, TimeBudget, IterationOrder, TileSize, Task);
+			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+		}
+	}
+}
+
+void UMultiFrameTaskLibrary::DoLoopBatchTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoopBatchTask> Class, int32& FirstX, int32& LastX, int32& Y, int32& Z, UMultiFrameLoopBatchTask*& Task, int32 XSize, int32 YSize, int32 ZSize, int32 BatchSize, int32 IterationsPerTick, float Delay, float TimeBudget)
+{
+	if (nullptr == WorldContextObject)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: Invalid WorldContextObject. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (nullptr == Class)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: Invalid Class. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (XSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: X Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (YSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: Y Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (ZSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: Z Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (BatchSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: Batch Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (IterationsPerTick <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: IterationsPerTick must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (Delay < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: Delay can't be lower than 0. We can't travel back in time, can we?"), ELogVerbosity::Error);
+		return;
+	}
+
+	if (TimeBudget < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: TimeBudget can't be lower than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+		FMultiFrameLoopBatchTaskAction* Action = LatentActionManager.FindExistingAction<FMultiFrameLoopBatchTaskAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+
+		if (Action && !Action->IsCanceled())
+		{
+			FFrame::KismetExecutionMessage(TEXT("DoLoopBatchTask: This node is already running."), ELogVerbosity::Error);
+			return;
+		}
+		else {
+			Action = new FMultiFrameLoopBatchTaskAction(WorldContextObject, Out, LatentInfo, Class, FirstX, LastX, Y, Z, XSize, YSize, ZSize, BatchSize, IterationsPerTick, Delay, TimeBudget, Task);
+			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+		}
+	}
+}
+
+void UMultiFrameTaskLibrary::DoParallelLoopTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameParallelLoopTask> Class, int32& FirstIndex, int32& LastIndex, UMultiFrameParallelLoopTask*& Task, int32 XSize, int32 YSize, int32 ZSize, int32 SliceSize, float Delay, UMultiTaskThreadPool* ThreadPool)
+{
+	if (nullptr == WorldContextObject)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: Invalid WorldContextObject. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (nullptr == Class)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: Invalid Class. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (XSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: X Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (YSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: Y Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (ZSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: Z Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (SliceSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: Slice Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (Delay < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: Delay can't be lower than 0. We can't travel back in time, can we?"), ELogVerbosity::Error);
+		return;
+	}
+
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+		FMultiFrameParallelLoopTaskAction* Action = LatentActionManager.FindExistingAction<FMultiFrameParallelLoopTaskAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+
+		if (Action && !Action->IsCanceled())
+		{
+			FFrame::KismetExecutionMessage(TEXT("DoParallelLoopTask: This node is already running."), ELogVerbosity::Error);
+			return;
+		}
+		else {
+			Action = new FMultiFrameParallelLoopTaskAction(WorldContextObject, Out, LatentInfo, Class, FirstIndex, LastIndex, XSize, YSize, ZSize, SliceSize, Delay, ThreadPool, Task);
+			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+		}
+	}
+}
+
+void UMultiFrameTaskLibrary::DoSparseLoopTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameSparseLoopTask> Class, int32& Index, int32& X, int32& Y, int32& Z, UMultiFrameSparseLoopTask*& Task, const TArray<int32>& Indices, const TArray<int64>& Mask, int32 XSize, int32 YSize, int32 IterationsPerTick, float Delay, float TimeBudget)
+{
+	if (nullptr == WorldContextObject)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: Invalid WorldContextObject. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (nullptr == Class)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: Invalid Class. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (XSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: X Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (YSize <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: Y Size must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (IterationsPerTick <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: IterationsPerTick must be higher than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (Delay < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: Delay can't be lower than 0. We can't travel back in time, can we?"), ELogVerbosity::Error);
+		return;
+	}
+
+	if (TimeBudget < 0.0f)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: TimeBudget can't be lower than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+		FMultiFrameSparseLoopTaskAction* Action = LatentActionManager.FindExistingAction<FMultiFrameSparseLoopTaskAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+
+		if (Action && !Action->IsCanceled())
+		{
+			FFrame::KismetExecutionMessage(TEXT("DoSparseLoopTask: This node is already running."), ELogVerbosity::Error);
+			return;
+		}
+		else {
+			Action = new FMultiFrameSparseLoopTaskAction(WorldContextObject, Out, LatentInfo, Class, Index, X, Y, Z, Indices, Mask, XSize, YSize, IterationsPerTick, Delay, TimeBudget, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
 }
+
+void UMultiFrameTaskLibrary::SetMaskBit(TArray<int64>& Mask, int32 Index, bool bValue)
+{
+	if (Index < 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("SetMaskBit: Index can't be lower than 0."), ELogVerbosity::Error);
+		return;
+	}
+
+	const int32 Word = Index / 64;
+	const uint64 Bit = 1ull << (Index % 64);
+	if (bValue)
+	{
+		if (Word >= Mask.Num())
+		{
+			Mask.AddZeroed(Word + 1 - Mask.Num());
+		}
+		Mask[Word] = (int64)((uint64)Mask[Word] | Bit);
+	}
+	else if (Word < Mask.Num())
+	{
+		Mask[Word] = (int64)((uint64)Mask[Word] & ~Bit);
+	}
+}
+
+UMultiFrameTaskScheduler* UMultiFrameTaskLibrary::GetMultiFrameScheduler()
+{
+	return FMultiTask2Module::Get().GetMultiFrameScheduler();
+}
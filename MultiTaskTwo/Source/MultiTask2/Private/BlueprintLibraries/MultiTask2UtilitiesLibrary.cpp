@@ -26,6 +26,8 @@ TArray<UObject*> UMultiTask2UtilitiesLibrary::RootObjects = {};
 int32 UMultiTask2UtilitiesLibrary::TaskIndex = 0;
 int32 UMultiTask2UtilitiesLibrary::MutexIndex = 0;
 int32 UMultiTask2UtilitiesLibrary::ThreadPoolIndex = 0;
+int32 UMultiTask2UtilitiesLibrary::GroupIndex = 0;
+int32 UMultiTask2UtilitiesLibrary::SyncObjectIndex = 0;
 
 UMultiTask2UtilitiesLibrary::UMultiTask2UtilitiesLibrary()
 {
@@ -46,6 +48,8 @@ UMultiTask2UtilitiesLibrary::~UMultiTask2UtilitiesLibrary()
     TaskIndex = 0;
     MutexIndex = 0;
     ThreadPoolIndex = 0;
+    GroupIndex = 0;
+    SyncObjectIndex = 0;
 }
 
 
@@ -287,7 +287,68 @@ void UMultiTask2VoxelLibrary::DoConvertVoxelDataToMeshDataTask(UObject* WorldCon
 			return;
 		}
 		else {
-			Action = new FVoxelDataToMeshDataTaskAction(WorldContextObject, Out, LatentInfo, Class, ChunkSlot, Settings, NormalType, bUseFlatShading, VoxelData, SimplifierSettings, MeshData, ExecutionType, ThreadPool, Task);
+			Action = new FVoxelDataToMeshDataTaskAction(WorldContextObject, Out, LatentInfo, Class, ChunkSlot, Settings, NormalType, bUseFlatShading, VoxelData, SimplifierSettings, &MeshData, nullptr, ExecutionType, ThreadPool, Task);
+			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+		}
+	}
+}
+
+void UMultiTask2VoxelLibrary::DoConvertVoxelDataToMeshDataBufferTask(UObject* WorldContextObject, FLatentActionInfo LatentInfo, TSubclassOf<class UGenerateMarchingCubesTask> Class, const FIntVector& ChunkSlot, const FMarchingCubesSettings& Settings, EMarchingCubesNormal NormalType, bool bUseFlatShading, UPARAM(ref)FMarchingCubesData& VoxelData, const TArray<FMarchingCubesSimplifierSettings>& SimplifierSettings, UGenerateMarchingCubesTask*& Task, FMultiTaskMeshDataBuffer& MeshData, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool)
+{
+	if (nullptr == WorldContextObject)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: Invalid WorldContextObject. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (nullptr == Class)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: Invalid Class. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (!(Settings.Units.X > VOXELMARGIN))
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: Units X Size must be higher than 4."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (!(Settings.Units.Y > VOXELMARGIN))
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: Units Y Size must be higher than 4."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (!(Settings.Units.Z > VOXELMARGIN))
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: Units Z Size must be higher than 4."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (FMath::IsNearlyZero(Settings.Resolution))
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: Resolution is too low."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (ExecutionType == ETaskExecutionType::ThreadPool && ThreadPool && ThreadPool->GetThreadsNum() <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: Invalid Thread Pool"), ELogVerbosity::Error);
+		return;
+	}
+
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+		FVoxelDataToMeshDataTaskAction* Action = LatentActionManager.FindExistingAction<FVoxelDataToMeshDataTaskAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+
+		if (Action && Action->IsRunning())
+		{
+			FFrame::KismetExecutionMessage(TEXT("DoConvertVoxelDataToMeshDataBufferTask: This node is already running."), ELogVerbosity::Error);
+			return;
+		}
+		else {
+			Action = new FVoxelDataToMeshDataTaskAction(WorldContextObject, Out, LatentInfo, Class, ChunkSlot, Settings, NormalType, bUseFlatShading, VoxelData, SimplifierSettings, nullptr, &MeshData, ExecutionType, ThreadPool, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
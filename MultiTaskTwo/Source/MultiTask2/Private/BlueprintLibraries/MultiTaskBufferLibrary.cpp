@@ -0,0 +1,138 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskBufferLibrary.h"
+#include "UObject/Script.h"
+
+FMultiTaskTransformBuffer UMultiTaskBufferLibrary::MakeTransformBuffer(const TArray<FTransform>& Transforms)
+{
+    FMultiTaskTransformBuffer Result;
+    Result.Buffer = TMultiTaskImmutableBuffer<FTransform>(TArray<FTransform>(Transforms));
+    return Result;
+}
+
+TArray<FTransform> UMultiTaskBufferLibrary::TransformBufferToArray(const FMultiTaskTransformBuffer& Buffer)
+{
+    return Buffer.Buffer.Get();
+}
+
+int32 UMultiTaskBufferLibrary::TransformBufferLength(const FMultiTaskTransformBuffer& Buffer)
+{
+    return Buffer.Buffer.Num();
+}
+
+FTransform UMultiTaskBufferLibrary::TransformBufferGet(const FMultiTaskTransformBuffer& Buffer, int32 Index)
+{
+    if (!Buffer.Buffer.IsValidIndex(Index))
+    {
+        FFrame::KismetExecutionMessage(*FString::Printf(TEXT("TransformBufferGet: Index %d out of bounds, the buffer has %d elements."), Index, Buffer.Buffer.Num()), ELogVerbosity::Error);
+        return FTransform::Identity;
+    }
+    return Buffer.Buffer.Get()[Index];
+}
+
+FMultiTaskFloatBuffer UMultiTaskBufferLibrary::MakeFloatBuffer(const TArray<float>& Floats)
+{
+    FMultiTaskFloatBuffer Result;
+    Result.Buffer = TMultiTaskImmutableBuffer<float>(TArray<float>(Floats));
+    return Result;
+}
+
+TArray<float> UMultiTaskBufferLibrary::FloatBufferToArray(const FMultiTaskFloatBuffer& Buffer)
+{
+    return Buffer.Buffer.Get();
+}
+
+int32 UMultiTaskBufferLibrary::FloatBufferLength(const FMultiTaskFloatBuffer& Buffer)
+{
+    return Buffer.Buffer.Num();
+}
+
+float UMultiTaskBufferLibrary::FloatBufferGet(const FMultiTaskFloatBuffer& Buffer, int32 Index)
+{
+    if (!Buffer.Buffer.IsValidIndex(Index))
+    {
+        FFrame::KismetExecutionMessage(*FString::Printf(TEXT("FloatBufferGet: Index %d out of bounds, the buffer has %d elements."), Index, Buffer.Buffer.Num()), ELogVerbosity::Error);
+        return 0.0f;
+    }
+    return Buffer.Buffer.Get()[Index];
+}
+
+FMultiTaskVectorBuffer UMultiTaskBufferLibrary::MakeVectorBuffer(const TArray<FVector>& Vectors)
+{
+    FMultiTaskVectorBuffer Result;
+    Result.Buffer = TMultiTaskImmutableBuffer<FVector>(TArray<FVector>(Vectors));
+    return Result;
+}
+
+TArray<FVector> UMultiTaskBufferLibrary::VectorBufferToArray(const FMultiTaskVectorBuffer& Buffer)
+{
+    return Buffer.Buffer.Get();
+}
+
+int32 UMultiTaskBufferLibrary::VectorBufferLength(const FMultiTaskVectorBuffer& Buffer)
+{
+    return Buffer.Buffer.Num();
+}
+
+FVector UMultiTaskBufferLibrary::VectorBufferGet(const FMultiTaskVectorBuffer& Buffer, int32 Index)
+{
+    if (!Buffer.Buffer.IsValidIndex(Index))
+    {
+        FFrame::KismetExecutionMessage(*FString::Printf(TEXT("VectorBufferGet: Index %d out of bounds, the buffer has %d elements."), Index, Buffer.Buffer.Num()), ELogVerbosity::Error);
+        return FVector::ZeroVector;
+    }
+    return Buffer.Buffer.Get()[Index];
+}
+
+FMultiTaskByteBuffer UMultiTaskBufferLibrary::MakeByteBuffer(const TArray<uint8>& Bytes)
+{
+    FMultiTaskByteBuffer Result;
+    Result.Buffer = TMultiTaskImmutableBuffer<uint8>(TArray<uint8>(Bytes));
+    return Result;
+}
+
+TArray<uint8> UMultiTaskBufferLibrary::ByteBufferToArray(const FMultiTaskByteBuffer& Buffer)
+{
+    return Buffer.Buffer.Get();
+}
+
+int32 UMultiTaskBufferLibrary::ByteBufferLength(const FMultiTaskByteBuffer& Buffer)
+{
+    return Buffer.Buffer.Num();
+}
+
+uint8 UMultiTaskBufferLibrary::ByteBufferGet(const FMultiTaskByteBuffer& Buffer, int32 Index)
+{
+    if (!Buffer.Buffer.IsValidIndex(Index))
+    {
+        FFrame::KismetExecutionMessage(*FString::Printf(TEXT("ByteBufferGet: Index %d out of bounds, the buffer has %d elements."), Index, Buffer.Buffer.Num()), ELogVerbosity::Error);
+        return 0;
+    }
+    return Buffer.Buffer.Get()[Index];
+}
+
+FMultiTaskMeshDataBuffer UMultiTaskBufferLibrary::MakeMeshDataBuffer(const TArray<FMarchingCubesMeshData>& MeshData)
+{
+    FMultiTaskMeshDataBuffer Result;
+    Result.Buffer = TMultiTaskImmutableBuffer<FMarchingCubesMeshData>(TArray<FMarchingCubesMeshData>(MeshData));
+    return Result;
+}
+
+TArray<FMarchingCubesMeshData> UMultiTaskBufferLibrary::MeshDataBufferToArray(const FMultiTaskMeshDataBuffer& Buffer)
+{
+    return Buffer.Buffer.Get();
+}
+
+int32 UMultiTaskBufferLibrary::MeshDataBufferLength(const FMultiTaskMeshDataBuffer& Buffer)
+{
+    return Buffer.Buffer.Num();
+}
+
+FMarchingCubesMeshData UMultiTaskBufferLibrary::MeshDataBufferGet(const FMultiTaskMeshDataBuffer& Buffer, int32 Index)
+{
+    if (!Buffer.Buffer.IsValidIndex(Index))
+    {
+        FFrame::KismetExecutionMessage(*FString::Printf(TEXT("MeshDataBufferGet: Index %d out of bounds, the buffer has %d elements."), Index, Buffer.Buffer.Num()), ELogVerbosity::Error);
+        return FMarchingCubesMeshData();
+    }
+    return Buffer.Buffer.Get()[Index];
+}
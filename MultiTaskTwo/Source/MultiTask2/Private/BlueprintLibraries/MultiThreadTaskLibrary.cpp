@@ -7,9 +7,17 @@
 #include "UObject/Script.h"
 #include "Misc/CoreMisc.h"
 #include "MultiTaskMutex.h"
+#include "MultiTaskGroup.h"
+#include "MultiTaskSyncObjects.h"
+#include "MultiTaskPipe.h"
+#include "MultiTaskCommandBuffer.h"
+#include "MultiTaskConcurrentContainers.h"
+#include "MultiTaskResultBuffers.h"
+#include "MultiTaskCostModel.h"
 #include "SpawnInstancesTask.h"
 #include "UpdateInstancesTask.h"
 #include "MultiTask2UtilitiesLibrary.h"
+#include "MultiTask2.h"
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "CoreGlobals.h"
 #include "Components/StaticMeshComponent.h"
@@ -175,7 +183,56 @@ void UMultiThreadTaskLibrary::DoSpawnInstances(UObject* WorldContextObject, FLat
 	}
 }
 
-void UMultiThreadTaskLibrary::DoUpdateInstances(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<float>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool)
+void UMultiThreadTaskLibrary::DoSpawnInstancesFromBuffer(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, const FMultiTaskTransformBuffer& Transforms, int32 Chunks, bool bWorldSpace, bool bCreatePhysicsBodies, UMultiTaskBase*& Task, TArray<int32>& NewInstances, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool)
+{
+	if (nullptr == WorldContextObject)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSpawnInstancesFromBuffer: Invalid WorldContextObject. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (Transforms.Buffer.Num() <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSpawnInstancesFromBuffer: Nothing to spawn. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (Chunks < 1)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSpawnInstancesFromBuffer: Chunks needs to be >= 1."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (ExecutionType == ETaskExecutionType::ThreadPool && ThreadPool && ThreadPool->GetThreadsNum() <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSpawnInstancesFromBuffer: Invalid Thread Pool"), ELogVerbosity::Error);
+		return;
+	}
+
+	if (nullptr == HISM)
+	{
+		FFrame::KismetExecutionMessage(TEXT("DoSpawnInstancesFromBuffer: Invalid HISM Component. Cannot execute."), ELogVerbosity::Error);
+		return;
+	}
+
+	if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+	{
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+		FSpawnInstancesTaskAction* Action = LatentActionManager.FindExistingAction<FSpawnInstancesTaskAction>(LatentInfo.CallbackTarget, LatentInfo.UUID);
+
+		if (Action && Action->IsRunning())
+		{
+			FFrame::KismetExecutionMessage(TEXT("DoSpawnInstancesFromBuffer: This node is already running."), ELogVerbosity::Error);
+			return;
+		}
+		else {
+			Action = new FSpawnInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, Transforms, bWorldSpace, bCreatePhysicsBodies, ExecutionType, ThreadPool, Task, NewInstances);
+			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+		}
+	}
+}
+
+void UMultiThreadTaskLibrary::DoUpdateInstances(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<float>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool, bool bPackedCustomData)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -246,13 +303,13 @@ void UMultiThreadTaskLibrary::DoUpdateInstances(UObject* WorldContextObject, FLa
 			return;
 		}
 		else {
-			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, ExecutionType, ThreadPool, Task);
+			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, bPackedCustomData, ExecutionType, ThreadPool, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
 }
 
-void UMultiThreadTaskLibrary::DoUpdateInstances2(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector2D>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool)
+void UMultiThreadTaskLibrary::DoUpdateInstances2(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector2D>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool, bool bPackedCustomData)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -323,13 +380,13 @@ void UMultiThreadTaskLibrary::DoUpdateInstances2(UObject* WorldContextObject, FL
 			return;
 		}
 		else {
-			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, ExecutionType, ThreadPool, Task);
+			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, bPackedCustomData, ExecutionType, ThreadPool, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
 }
 
-void UMultiThreadTaskLibrary::DoUpdateInstances3(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool)
+void UMultiThreadTaskLibrary::DoUpdateInstances3(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool, bool bPackedCustomData)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -400,13 +457,13 @@ void UMultiThreadTaskLibrary::DoUpdateInstances3(UObject* WorldContextObject, FL
 			return;
 		}
 		else {
-			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, ExecutionType, ThreadPool, Task);
+			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, bPackedCustomData, ExecutionType, ThreadPool, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
 }
 
-void UMultiThreadTaskLibrary::DoUpdateInstances4(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector4>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool)
+void UMultiThreadTaskLibrary::DoUpdateInstances4(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector4>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType, UMultiTaskThreadPool* ThreadPool, bool bPackedCustomData)
 {
 	if (nullptr == WorldContextObject)
 	{
@@ -477,7 +534,7 @@ void UMultiThreadTaskLibrary::DoUpdateInstances4(UObject* WorldContextObject, FL
 			return;
 		}
 		else {
-			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, ExecutionType, ThreadPool, Task);
+			Action = new FUpdateInstancesTaskAction(WorldContextObject, Out, LatentInfo, Chunks, HISM, StartIndex, Transforms, CustomData.GetData(), CustomData.Num(), DataSizeType, bWorldSpace, bTeleport, bUpdatePhysicsBodies, bMarkRenderStateDirty, bCreateInternalDataCopies, bPackedCustomData, ExecutionType, ThreadPool, Task);
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
 		}
 	}
@@ -573,34 +630,7 @@ UMultiTaskThreadPool* UMultiThreadTaskLibrary::CreateThreadPool(UObject* WorldCo
 	ThreadPool = NewObject<UMultiTaskThreadPool>(WorldContextObject, FName(*PoolName), RF_Transient);
 	if (ThreadPool)
 	{
-		EThreadPriority LocalThreadPriority = EThreadPriority::TPri_Normal;
-		switch (ThreadPriority)
-		{
-		case EMultiTaskThreadPriority::AboveNormal:
-			LocalThreadPriority = EThreadPriority::TPri_AboveNormal;
-			break;
-		case EMultiTaskThreadPriority::BelowNormal:
-			LocalThreadPriority = EThreadPriority::TPri_BelowNormal;
-			break;
-		case EMultiTaskThreadPriority::Highest:
-			LocalThreadPriority = EThreadPriority::TPri_Highest;
-			break;
-		case EMultiTaskThreadPriority::Lowest:
-			LocalThreadPriority = EThreadPriority::TPri_Lowest;
-			break;
-		case EMultiTaskThreadPriority::Normal:
-			LocalThreadPriority = EThreadPriority::TPri_Normal;
-			break;
-		case EMultiTaskThreadPriority::SlightlyBelowNormal:
-			LocalThreadPriority = EThreadPriority::TPri_SlightlyBelowNormal;
-			break;
-		case EMultiTaskThreadPriority::TimeCritical:
-			LocalThreadPriority = EThreadPriority::TPri_TimeCritical;
-			break;
-		default:
-			LocalThreadPriority = EThreadPriority::TPri_Normal;
-		}
-
+		const EThreadPriority LocalThreadPriority = UMultiTaskThreadPool::ToThreadPriority(ThreadPriority);
 		const bool bResult = ThreadPool->Create((uint32)NumQueuedThreads, (uint32)StackSize, LocalThreadPriority, Name);
 
 		if (bResult)
@@ -618,6 +648,25 @@ UMultiTaskThreadPool* UMultiThreadTaskLibrary::CreateThreadPool(UObject* WorldCo
 	return nullptr;
 }
 
+UMultiTaskThreadPool* UMultiThreadTaskLibrary::GetThreadPoolByName(FName Name)
+{
+	return FMultiTask2Module::Get().FindThreadPool(Name);
+}
+
+float UMultiThreadTaskLibrary::GetExpectedTaskCost(TSubclassOf<class UThreadTaskBase> Class, int32 WorkSize)
+{
+	if (nullptr == Class)
+	{
+		return -1.0f;
+	}
+	return (float)FMultiTaskCostModel::Get().Estimate(Class->GetFName(), WorkSize);
+}
+
+void UMultiThreadTaskLibrary::ResetTaskCostModel()
+{
+	FMultiTaskCostModel::Get().Reset();
+}
+
 void UMultiThreadTaskLibrary::DestroyThreadPoolImmediately(UMultiTaskThreadPool* ThreadPool)
 {
 	UMultiTask2UtilitiesLibrary::RemoveFromRoot(ThreadPool);
@@ -634,6 +683,121 @@ UMultiTaskMutex* UMultiThreadTaskLibrary::CreateMutex(UObject* WorldContextObjec
 	return NewObject<UMultiTaskMutex>(WorldContextObject, FName(*Name), RF_Transient);
 }
 
+UMultiTaskGroup* UMultiThreadTaskLibrary::CreateTaskGroup(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::GroupIndex++;
+	const FString Name = "MultiTaskGroup" + FString::FromInt(UMultiTask2UtilitiesLibrary::GroupIndex);
+	return NewObject<UMultiTaskGroup>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
+UMultiTaskBarrier* UMultiThreadTaskLibrary::CreateBarrier(UObject* WorldContextObject, int32 Participants)
+{
+	if (Participants <= 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("CreateBarrier: Participants must be >= 1."), ELogVerbosity::Error);
+		return nullptr;
+	}
+
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskBarrier" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	UMultiTaskBarrier* Barrier = NewObject<UMultiTaskBarrier>(WorldContextObject, FName(*Name), RF_Transient);
+	Barrier->Init(Participants);
+	return Barrier;
+}
+
+UMultiTaskLatch* UMultiThreadTaskLibrary::CreateLatch(UObject* WorldContextObject, int32 Count)
+{
+	if (Count < 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("CreateLatch: Count must be >= 0."), ELogVerbosity::Error);
+		return nullptr;
+	}
+
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskLatch" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	UMultiTaskLatch* Latch = NewObject<UMultiTaskLatch>(WorldContextObject, FName(*Name), RF_Transient);
+	Latch->Init(Count);
+	return Latch;
+}
+
+UMultiTaskSemaphore* UMultiThreadTaskLibrary::CreateSemaphore(UObject* WorldContextObject, int32 InitialCount)
+{
+	if (InitialCount < 0)
+	{
+		FFrame::KismetExecutionMessage(TEXT("CreateSemaphore: InitialCount must be >= 0."), ELogVerbosity::Error);
+		return nullptr;
+	}
+
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskSemaphore" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	UMultiTaskSemaphore* Semaphore = NewObject<UMultiTaskSemaphore>(WorldContextObject, FName(*Name), RF_Transient);
+	Semaphore->Init(InitialCount);
+	return Semaphore;
+}
+
+UMultiTaskPipe* UMultiThreadTaskLibrary::CreatePipe(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskPipe" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	return NewObject<UMultiTaskPipe>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
+UMultiTaskCommandBuffer* UMultiThreadTaskLibrary::GetCommandBuffer()
+{
+	return FMultiTask2Module::Get().GetCommandBuffer();
+}
+
+UMultiTaskCommandBuffer* UMultiThreadTaskLibrary::CreateCommandBuffer(UObject* WorldContextObject, float FrameBudget)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskCommandBuffer" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	UMultiTaskCommandBuffer* CommandBuffer = NewObject<UMultiTaskCommandBuffer>(WorldContextObject, FName(*Name), RF_Transient);
+	CommandBuffer->FrameBudget = FMath::Max(FrameBudget, 0.0f);
+	return CommandBuffer;
+}
+
+UMultiTaskConcurrentMap* UMultiThreadTaskLibrary::CreateConcurrentMap(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskConcurrentMap" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	return NewObject<UMultiTaskConcurrentMap>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
+UMultiTaskConcurrentSet* UMultiThreadTaskLibrary::CreateConcurrentSet(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskConcurrentSet" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	return NewObject<UMultiTaskConcurrentSet>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
+UMultiTaskConcurrentArray* UMultiThreadTaskLibrary::CreateConcurrentArray(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskConcurrentArray" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	return NewObject<UMultiTaskConcurrentArray>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
+UMultiTaskTransformResultBuffer* UMultiThreadTaskLibrary::CreateTransformResultBuffer(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskTransformResultBuffer" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	return NewObject<UMultiTaskTransformResultBuffer>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
+UMultiTaskFloatResultBuffer* UMultiThreadTaskLibrary::CreateFloatResultBuffer(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskFloatResultBuffer" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	return NewObject<UMultiTaskFloatResultBuffer>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
+UMultiTaskVectorResultBuffer* UMultiThreadTaskLibrary::CreateVectorResultBuffer(UObject* WorldContextObject)
+{
+	UMultiTask2UtilitiesLibrary::SyncObjectIndex++;
+	const FString Name = "MultiTaskVectorResultBuffer" + FString::FromInt(UMultiTask2UtilitiesLibrary::SyncObjectIndex);
+	return NewObject<UMultiTaskVectorResultBuffer>(WorldContextObject, FName(*Name), RF_Transient);
+}
+
 void UMultiThreadTaskLibrary::Sleep(float Seconds)
 {
 	if (!IsInGameThread())
@@ -0,0 +1,204 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiFrameTaskScheduler.h"
+#include "MultiFrameTaskBase.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+void FMultiFrameSchedulerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Scheduler && World.IsValid())
+	{
+		Scheduler->Serve(DeltaTime, World.Get(), TickGroup.GetValue());
+	}
+}
+
+FString FMultiFrameSchedulerTickFunction::DiagnosticMessage()
+{
+	return TEXT("FMultiFrameSchedulerTickFunction");
+}
+
+void UMultiFrameTaskScheduler::Register(UMultiFrameTaskBase* Task)
+{
+	check(IsInGameThread());
+	if (IsValid(Task))
+	{
+		Task->LastServedFrame = FrameCounter;
+		Tasks.AddUnique(Task);
+		if (Task->bUseTickGroup)
+		{
+			if (UWorld* World = Task->GetWorld())
+			{
+				EnsureTickFunction(World, Task->TickGroup);
+			}
+		}
+	}
+}
+
+int32 UMultiFrameTaskScheduler::GetTasksNum()
+{
+	return Tasks.Num();
+}
+
+void UMultiFrameTaskScheduler::BeginDestroy()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	for (const TUniquePtr<FMultiFrameSchedulerTickFunction>& TickFunction : TickFunctions)
+	{
+		TickFunction->UnRegisterTickFunction();
+	}
+	TickFunctions.Empty();
+	Super::BeginDestroy();
+}
+
+void UMultiFrameTaskScheduler::EnsureTickFunction(UWorld* World, ETickingGroup Group)
+{
+	for (const TUniquePtr<FMultiFrameSchedulerTickFunction>& TickFunction : TickFunctions)
+	{
+		if (TickFunction->World.Get() == World && TickFunction->TickGroup == Group)
+		{
+			return;
+		}
+	}
+
+	if (nullptr == World->PersistentLevel)
+	{
+		return;
+	}
+
+	if (!WorldCleanupHandle.IsValid())
+	{
+		WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UMultiFrameTaskScheduler::OnWorldCleanup);
+	}
+
+	TUniquePtr<FMultiFrameSchedulerTickFunction> TickFunction = MakeUnique<FMultiFrameSchedulerTickFunction>();
+	TickFunction->Scheduler = this;
+	TickFunction->World = World;
+	TickFunction->bCanEverTick = true;
+	TickFunction->bTickEvenWhenPaused = true;
+	TickFunction->TickGroup = Group;
+	TickFunction->EndTickGroup = Group;
+	TickFunction->RegisterTickFunction(World->PersistentLevel);
+	TickFunctions.Add(MoveTemp(TickFunction));
+}
+
+void UMultiFrameTaskScheduler::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	TickFunctions.RemoveAll([World](const TUniquePtr<FMultiFrameSchedulerTickFunction>& TickFunction)
+	{
+		if (!TickFunction->World.IsValid() || TickFunction->World.Get() == World)
+		{
+			TickFunction->UnRegisterTickFunction();
+			return true;
+		}
+		return false;
+	});
+}
+
+bool UMultiFrameTaskScheduler::CanServe(const UMultiFrameTaskBase* Task)
+{
+	if (!IsValid(Task) || Task->HasAnyFlags(RF_BeginDestroyed) || Task->IsUnreachable())
+	{
+		return false;
+	}
+	if (UWorld* World = Task->GetWorld())
+	{
+		if (World->IsPaused() && !Task->bIsTickableWhenPaused)
+		{
+			return false;
+		}
+		if (!World->IsGameWorld() && !Task->bIsTickableInEditor)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UMultiFrameTaskScheduler::IsServedBy(const UMultiFrameTaskBase* Task, UWorld* World, ETickingGroup Group)
+{
+	UWorld* TaskWorld = Task->GetWorld();
+	if (nullptr == World)
+	{
+		return !Task->bUseTickGroup || nullptr == TaskWorld;
+	}
+	return Task->bUseTickGroup && TaskWorld == World && Task->TickGroup == Group;
+}
+
+void UMultiFrameTaskScheduler::Serve(float DeltaTime, UWorld* World, ETickingGroup Group)
+{
+	Tasks.RemoveAll([](const TWeakObjectPtr<UMultiFrameTaskBase>& Task)
+	{
+		return !Task.IsValid();
+	});
+
+	// Highest priority first, then the Tasks that waited the longest.
+	Tasks.StableSort([](const TWeakObjectPtr<UMultiFrameTaskBase>& A, const TWeakObjectPtr<UMultiFrameTaskBase>& B)
+	{
+		if (A->Priority != B->Priority)
+		{
+			return (uint8)A->Priority < (uint8)B->Priority;
+		}
+		return A->LastServedFrame < B->LastServedFrame;
+	});
+
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		BudgetSpent = 0.0;
+	}
+
+	FrameCounter++;
+	const double StartTime = FPlatformTime::Seconds();
+	const double FrameEndTime = FrameBudget > 0.0f ? StartTime + FMath::Max((double)FrameBudget / 1000.0 - BudgetSpent, 0.0) : 0.0;
+	bool bBudgetSpent = false;
+
+	// Task Bodies may start new Multi-Frame Tasks, so the array can grow while it is iterated.
+	for (int32 Index = 0; Index < Tasks.Num(); ++Index)
+	{
+		UMultiFrameTaskBase* Task = Tasks[Index].Get();
+		if (!CanServe(Task) || !IsServedBy(Task, World, Group))
+		{
+			continue;
+		}
+
+		if (Task->AdvanceDelay(DeltaTime) && !bBudgetSpent)
+		{
+			Task->RunIterations(FrameEndTime);
+			Task->LastServedFrame = FrameCounter;
+			bBudgetSpent = FrameEndTime > 0.0 && FPlatformTime::Seconds() >= FrameEndTime;
+		}
+
+		if (!Task->IsRunning())
+		{
+			Task->LeaveGroup();
+			Tasks[Index].Reset();
+		}
+	}
+
+	BudgetSpent += FPlatformTime::Seconds() - StartTime;
+}
+
+void UMultiFrameTaskScheduler::Tick(float DeltaTime)
+{
+	Serve(DeltaTime, nullptr, TG_PrePhysics);
+}
+
+bool UMultiFrameTaskScheduler::IsTickable() const
+{
+	return Tasks.Num() > 0 && !HasAnyFlags(RF_ClassDefaultObject | RF_BeginDestroyed);
+}
+
+bool UMultiFrameTaskScheduler::IsTickableWhenPaused() const
+{
+	return true;
+}
+
+bool UMultiFrameTaskScheduler::IsTickableInEditor() const
+{
+	return true;
+}
+
+TStatId UMultiFrameTaskScheduler::GetStatId() const
+{
+	return TStatId();
+}
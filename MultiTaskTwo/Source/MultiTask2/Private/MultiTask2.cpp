@@ -1,15 +1,113 @@
 // Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
 
 #include "MultiTask2.h"
+#include "MultiTask2Settings.h"
+#include "MultiTaskThreadPool.h"
+#include "MultiTaskCommandBuffer.h"
+#include "MultiFrameTaskScheduler.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
 
 #define LOCTEXT_NAMESPACE "FMultiTask2Module"
 
 void FMultiTask2Module::StartupModule()
 {
+    if (UObjectInitialized())
+    {
+        CreateThreadPools();
+    }
+    else {
+        PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FMultiTask2Module::CreateThreadPools);
+    }
 }
 
 void FMultiTask2Module::ShutdownModule()
 {
+    FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+    DestroyThreadPools();
+}
+
+FMultiTask2Module& FMultiTask2Module::Get()
+{
+    return FModuleManager::GetModuleChecked<FMultiTask2Module>("MultiTask2");
+}
+
+UMultiTaskThreadPool* FMultiTask2Module::FindThreadPool(FName Name) const
+{
+    UMultiTaskThreadPool* const* ThreadPool = ThreadPools.Find(Name);
+    return ThreadPool ? *ThreadPool : nullptr;
+}
+
+UMultiTaskCommandBuffer* FMultiTask2Module::GetCommandBuffer() const
+{
+    return CommandBuffer;
+}
+
+UMultiFrameTaskScheduler* FMultiTask2Module::GetMultiFrameScheduler() const
+{
+    return MultiFrameScheduler;
+}
+
+void FMultiTask2Module::CreateThreadPools()
+{
+    const UMultiTask2Settings* Settings = GetDefault<UMultiTask2Settings>();
+    if (nullptr == CommandBuffer)
+    {
+        CommandBuffer = NewObject<UMultiTaskCommandBuffer>(GetTransientPackage(), FName(TEXT("MultiTaskCommandBuffer_Default")), RF_Transient);
+        CommandBuffer->FrameBudget = Settings->CommandBufferFrameBudget;
+        CommandBuffer->AddToRoot();
+    }
+    if (nullptr == MultiFrameScheduler)
+    {
+        MultiFrameScheduler = NewObject<UMultiFrameTaskScheduler>(GetTransientPackage(), FName(TEXT("MultiFrameTaskScheduler_Default")), RF_Transient);
+        MultiFrameScheduler->FrameBudget = Settings->MultiFrameFrameBudget;
+        MultiFrameScheduler->AddToRoot();
+    }
+
+    for (const FMultiTaskThreadPoolSettings& PoolSettings : Settings->ThreadPools)
+    {
+        if (PoolSettings.Name.IsNone() || PoolSettings.NumQueuedThreads <= 0 || ThreadPools.Contains(PoolSettings.Name))
+        {
+            continue;
+        }
+
+        const FString PoolName = "MultiTaskThreadPool_" + PoolSettings.Name.ToString();
+        UMultiTaskThreadPool* ThreadPool = NewObject<UMultiTaskThreadPool>(GetTransientPackage(), FName(*PoolName), RF_Transient);
+        const EThreadPriority ThreadPriority = UMultiTaskThreadPool::ToThreadPriority(PoolSettings.ThreadPriority);
+        if (ThreadPool->Create((uint32)PoolSettings.NumQueuedThreads, (uint32)PoolSettings.StackSize, ThreadPriority, PoolSettings.Name.ToString()))
+        {
+            ThreadPool->SetThreadsAffinity((uint64)PoolSettings.AffinityMask);
+            ThreadPool->AddToRoot();
+            ThreadPools.Add(PoolSettings.Name, ThreadPool);
+        }
+        else {
+            ThreadPool->ConditionalBeginDestroy();
+        }
+    }
+}
+
+void FMultiTask2Module::DestroyThreadPools()
+{
+    if (UObjectInitialized())
+    {
+        for (const TPair<FName, UMultiTaskThreadPool*>& Pair : ThreadPools)
+        {
+            Pair.Value->RemoveFromRoot();
+            Pair.Value->Obj.Reset();
+        }
+        if (CommandBuffer)
+        {
+            CommandBuffer->RemoveFromRoot();
+        }
+        if (MultiFrameScheduler)
+        {
+            MultiFrameScheduler->RemoveFromRoot();
+        }
+    }
+    ThreadPools.Empty();
+    CommandBuffer = nullptr;
+    MultiFrameScheduler = nullptr;
 }
 
 #undef LOCTEXT_NAMESPACE
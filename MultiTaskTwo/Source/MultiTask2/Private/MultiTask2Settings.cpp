@@ -0,0 +1,8 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTask2Settings.h"
+
+UMultiTask2Settings::UMultiTask2Settings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("MultiTask2");
+}
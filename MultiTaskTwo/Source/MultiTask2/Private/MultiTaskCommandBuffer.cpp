@@ -0,0 +1,222 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskCommandBuffer.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "UObject/Script.h"
+#include "UObject/UnrealType.h"
+
+static bool IsCommandTargetValid(const UObject* Target)
+{
+	return IsValid(Target) && !Target->HasAnyFlags(RF_BeginDestroyed) && !Target->IsUnreachable();
+}
+
+template<typename PropertyType>
+static PropertyType* FindCommandProperty(UObject* Target, FName PropertyName, const TCHAR* FunctionName)
+{
+	PropertyType* Property = FindFProperty<PropertyType>(Target->GetClass(), PropertyName);
+	if (nullptr == Property)
+	{
+		FFrame::KismetExecutionMessage(*FString::Printf(TEXT("%s: %s has no matching property %s."), FunctionName, *Target->GetName(), *PropertyName.ToString()), ELogVerbosity::Error);
+	}
+	return Property;
+}
+
+void UMultiTaskCommandBuffer::Enqueue(TUniqueFunction<void()>&& Command)
+{
+	if (Command)
+	{
+		PendingCommands.Increment();
+		Commands.Enqueue(MoveTemp(Command));
+	}
+}
+
+void UMultiTaskCommandBuffer::Enqueue(UObject* Target, TUniqueFunction<void(UObject*)>&& Command)
+{
+	if (!IsCommandTargetValid(Target) || !Command)
+	{
+		return;
+	}
+
+	TWeakObjectPtr<UObject> WeakTarget(Target);
+	Enqueue([WeakTarget, Command = MoveTemp(Command)]() mutable
+	{
+		UObject* LocalTarget = WeakTarget.Get();
+		if (IsCommandTargetValid(LocalTarget))
+		{
+			Command(LocalTarget);
+		}
+	});
+}
+
+void UMultiTaskCommandBuffer::CallFunction(UObject* Target, FName FunctionName)
+{
+	Enqueue(Target, [FunctionName](UObject* LocalTarget)
+	{
+		UFunction* Function = LocalTarget->FindFunction(FunctionName);
+		if (nullptr == Function || Function->ParmsSize > 0)
+		{
+			FFrame::KismetExecutionMessage(*FString::Printf(TEXT("CallFunction: %s has no function %s without parameters."), *LocalTarget->GetName(), *FunctionName.ToString()), ELogVerbosity::Error);
+			return;
+		}
+		LocalTarget->ProcessEvent(Function, nullptr);
+	});
+}
+
+void UMultiTaskCommandBuffer::SetBoolProperty(UObject* Target, FName PropertyName, bool Value)
+{
+	Enqueue(Target, [PropertyName, Value](UObject* LocalTarget)
+	{
+		if (FBoolProperty* Property = FindCommandProperty<FBoolProperty>(LocalTarget, PropertyName, TEXT("SetBoolProperty")))
+		{
+			Property->SetPropertyValue_InContainer(LocalTarget, Value);
+		}
+	});
+}
+
+void UMultiTaskCommandBuffer::SetIntegerProperty(UObject* Target, FName PropertyName, int64 Value)
+{
+	Enqueue(Target, [PropertyName, Value](UObject* LocalTarget)
+	{
+		FNumericProperty* Property = FindCommandProperty<FNumericProperty>(LocalTarget, PropertyName, TEXT("SetIntegerProperty"));
+		if (Property && Property->IsInteger())
+		{
+			Property->SetIntPropertyValue(Property->ContainerPtrToValuePtr<void>(LocalTarget), Value);
+		}
+	});
+}
+
+void UMultiTaskCommandBuffer::SetFloatProperty(UObject* Target, FName PropertyName, double Value)
+{
+	Enqueue(Target, [PropertyName, Value](UObject* LocalTarget)
+	{
+		FNumericProperty* Property = FindCommandProperty<FNumericProperty>(LocalTarget, PropertyName, TEXT("SetFloatProperty"));
+		if (Property && Property->IsFloatingPoint())
+		{
+			Property->SetFloatingPointPropertyValue(Property->ContainerPtrToValuePtr<void>(LocalTarget), Value);
+		}
+	});
+}
+
+void UMultiTaskCommandBuffer::SetVectorProperty(UObject* Target, FName PropertyName, FVector Value)
+{
+	Enqueue(Target, [PropertyName, Value](UObject* LocalTarget)
+	{
+		FStructProperty* Property = FindCommandProperty<FStructProperty>(LocalTarget, PropertyName, TEXT("SetVectorProperty"));
+		if (Property && Property->Struct == TBaseStructure<FVector>::Get())
+		{
+			*Property->ContainerPtrToValuePtr<FVector>(LocalTarget) = Value;
+		}
+	});
+}
+
+void UMultiTaskCommandBuffer::SetStringProperty(UObject* Target, FName PropertyName, const FString& Value)
+{
+	Enqueue(Target, [PropertyName, Value](UObject* LocalTarget)
+	{
+		if (FStrProperty* Property = FindCommandProperty<FStrProperty>(LocalTarget, PropertyName, TEXT("SetStringProperty")))
+		{
+			Property->SetPropertyValue_InContainer(LocalTarget, Value);
+		}
+	});
+}
+
+void UMultiTaskCommandBuffer::SetActorTransform(AActor* Actor, FTransform Transform)
+{
+	Enqueue(Actor, [Transform](UObject* LocalTarget)
+	{
+		CastChecked<AActor>(LocalTarget)->SetActorTransform(Transform);
+	});
+}
+
+void UMultiTaskCommandBuffer::SetComponentWorldTransform(USceneComponent* Component, FTransform Transform)
+{
+	Enqueue(Component, [Transform](UObject* LocalTarget)
+	{
+		CastChecked<USceneComponent>(LocalTarget)->SetWorldTransform(Transform);
+	});
+}
+
+void UMultiTaskCommandBuffer::SetComponentRelativeTransform(USceneComponent* Component, FTransform Transform)
+{
+	Enqueue(Component, [Transform](UObject* LocalTarget)
+	{
+		CastChecked<USceneComponent>(LocalTarget)->SetRelativeTransform(Transform);
+	});
+}
+
+void UMultiTaskCommandBuffer::SetComponentVisibility(USceneComponent* Component, bool bNewVisibility, bool bPropagateToChildren)
+{
+	Enqueue(Component, [bNewVisibility, bPropagateToChildren](UObject* LocalTarget)
+	{
+		CastChecked<USceneComponent>(LocalTarget)->SetVisibility(bNewVisibility, bPropagateToChildren);
+	});
+}
+
+void UMultiTaskCommandBuffer::DestroyComponent(UActorComponent* Component)
+{
+	Enqueue(Component, [](UObject* LocalTarget)
+	{
+		CastChecked<UActorComponent>(LocalTarget)->DestroyComponent();
+	});
+}
+
+int32 UMultiTaskCommandBuffer::GetPendingCommandsNum()
+{
+	return PendingCommands.GetValue();
+}
+
+int32 UMultiTaskCommandBuffer::Flush()
+{
+	if (!IsInGameThread())
+	{
+		FFrame::KismetExecutionMessage(TEXT("Flush: Command Buffer can only be flushed on Game Thread."), ELogVerbosity::Error);
+		return 0;
+	}
+	return Execute(0.0);
+}
+
+int32 UMultiTaskCommandBuffer::Execute(double BudgetSeconds)
+{
+	// Only commands queued before the flush started run, commands queued by commands wait for the next one.
+	const int32 Available = PendingCommands.GetValue();
+	const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+	int32 Executed = 0;
+	TUniqueFunction<void()> Command;
+	while (Executed < Available && Commands.Dequeue(Command))
+	{
+		PendingCommands.Decrement();
+		Command();
+		Command = nullptr;
+		Executed++;
+		if (BudgetSeconds > 0.0 && FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+	return Executed;
+}
+
+void UMultiTaskCommandBuffer::Tick(float DeltaTime)
+{
+	Execute(FrameBudget / 1000.0);
+}
+
+bool UMultiTaskCommandBuffer::IsTickable() const
+{
+	return PendingCommands.GetValue() > 0 && !HasAnyFlags(RF_ClassDefaultObject | RF_BeginDestroyed);
+}
+
+bool UMultiTaskCommandBuffer::IsTickableWhenPaused() const
+{
+	return true;
+}
+
+bool UMultiTaskCommandBuffer::IsTickableInEditor() const
+{
+	return true;
+}
+
+TStatId UMultiTaskCommandBuffer::GetStatId() const
+{
+	return TStatId();
+}
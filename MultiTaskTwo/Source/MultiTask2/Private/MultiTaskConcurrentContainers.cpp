@@ -0,0 +1,179 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskConcurrentContainers.h"
+#include "UObject/Script.h"
+
+void UMultiTaskConcurrentMap::SetByInteger(int64 Key, int32 Value)
+{
+	IntegerMap.Set(Key, Value);
+}
+
+bool UMultiTaskConcurrentMap::TryAddByInteger(int64 Key, int32 Value)
+{
+	return IntegerMap.TryAdd(Key, Value);
+}
+
+bool UMultiTaskConcurrentMap::FindByInteger(int64 Key, int32& Value)
+{
+	return IntegerMap.Find(Key, Value);
+}
+
+int32 UMultiTaskConcurrentMap::IncrementByInteger(int64 Key, int32 Amount)
+{
+	return IntegerMap.Update(Key, [Amount](int32& Value) { Value += Amount; });
+}
+
+bool UMultiTaskConcurrentMap::RemoveByInteger(int64 Key)
+{
+	return IntegerMap.Remove(Key);
+}
+
+void UMultiTaskConcurrentMap::SetByName(FName Key, int32 Value)
+{
+	NameMap.Set(Key, Value);
+}
+
+bool UMultiTaskConcurrentMap::TryAddByName(FName Key, int32 Value)
+{
+	return NameMap.TryAdd(Key, Value);
+}
+
+bool UMultiTaskConcurrentMap::FindByName(FName Key, int32& Value)
+{
+	return NameMap.Find(Key, Value);
+}
+
+int32 UMultiTaskConcurrentMap::IncrementByName(FName Key, int32 Amount)
+{
+	return NameMap.Update(Key, [Amount](int32& Value) { Value += Amount; });
+}
+
+bool UMultiTaskConcurrentMap::RemoveByName(FName Key)
+{
+	return NameMap.Remove(Key);
+}
+
+void UMultiTaskConcurrentMap::SetByVector(FVector Key, int32 Value)
+{
+	VectorMap.Set(Key, Value);
+}
+
+bool UMultiTaskConcurrentMap::TryAddByVector(FVector Key, int32 Value)
+{
+	return VectorMap.TryAdd(Key, Value);
+}
+
+bool UMultiTaskConcurrentMap::FindByVector(FVector Key, int32& Value)
+{
+	return VectorMap.Find(Key, Value);
+}
+
+int32 UMultiTaskConcurrentMap::IncrementByVector(FVector Key, int32 Amount)
+{
+	return VectorMap.Update(Key, [Amount](int32& Value) { Value += Amount; });
+}
+
+bool UMultiTaskConcurrentMap::RemoveByVector(FVector Key)
+{
+	return VectorMap.Remove(Key);
+}
+
+int32 UMultiTaskConcurrentMap::Num()
+{
+	return IntegerMap.Num() + NameMap.Num() + VectorMap.Num();
+}
+
+void UMultiTaskConcurrentMap::Empty()
+{
+	IntegerMap.Empty();
+	NameMap.Empty();
+	VectorMap.Empty();
+}
+
+bool UMultiTaskConcurrentSet::AddInteger(int64 Key)
+{
+	return IntegerSet.Add(Key);
+}
+
+bool UMultiTaskConcurrentSet::ContainsInteger(int64 Key)
+{
+	return IntegerSet.Contains(Key);
+}
+
+bool UMultiTaskConcurrentSet::RemoveInteger(int64 Key)
+{
+	return IntegerSet.Remove(Key);
+}
+
+bool UMultiTaskConcurrentSet::AddName(FName Key)
+{
+	return NameSet.Add(Key);
+}
+
+bool UMultiTaskConcurrentSet::ContainsName(FName Key)
+{
+	return NameSet.Contains(Key);
+}
+
+bool UMultiTaskConcurrentSet::RemoveName(FName Key)
+{
+	return NameSet.Remove(Key);
+}
+
+bool UMultiTaskConcurrentSet::AddVector(FVector Key)
+{
+	return VectorSet.Add(Key);
+}
+
+bool UMultiTaskConcurrentSet::ContainsVector(FVector Key)
+{
+	return VectorSet.Contains(Key);
+}
+
+bool UMultiTaskConcurrentSet::RemoveVector(FVector Key)
+{
+	return VectorSet.Remove(Key);
+}
+
+int32 UMultiTaskConcurrentSet::Num()
+{
+	return IntegerSet.Num() + NameSet.Num() + VectorSet.Num();
+}
+
+void UMultiTaskConcurrentSet::Empty()
+{
+	IntegerSet.Empty();
+	NameSet.Empty();
+	VectorSet.Empty();
+}
+
+int32 UMultiTaskConcurrentArray::Add(FVector Element)
+{
+	return Elements.Add(Element);
+}
+
+FVector UMultiTaskConcurrentArray::Get(int32 Index)
+{
+	if (!Elements.IsValidIndex(Index))
+	{
+		FFrame::KismetExecutionMessage(*FString::Printf(TEXT("Get: Index %d out of bounds, the array has %d elements."), Index, Elements.Num()), ELogVerbosity::Error);
+		return FVector::ZeroVector;
+	}
+	return Elements[Index];
+}
+
+int32 UMultiTaskConcurrentArray::Num()
+{
+	return Elements.Num();
+}
+
+TArray<FVector> UMultiTaskConcurrentArray::ToArray()
+{
+	TArray<FVector> Result;
+	Elements.CopyTo(Result);
+	return Result;
+}
+
+void UMultiTaskConcurrentArray::Empty()
+{
+	Elements.Empty();
+}
@@ -0,0 +1,75 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskCostModel.h"
+
+// Weight of the newest sample in the moving average.
+static constexpr double CostSmoothing = 0.2;
+
+FMultiTaskCostModel& FMultiTaskCostModel::Get()
+{
+	static FMultiTaskCostModel Instance;
+	return Instance;
+}
+
+void FMultiTaskCostModel::Record(FName TaskClass, int32 WorkSize, double Milliseconds)
+{
+	FScopeLock Lock(&Section);
+	FCostEntry& Entry = Entries.FindOrAdd(TaskClass).FindOrAdd(GetSizeBucket(WorkSize));
+	if (Entry.Samples == 0)
+	{
+		Entry.AverageMilliseconds = Milliseconds;
+	}
+	else {
+		Entry.AverageMilliseconds += (Milliseconds - Entry.AverageMilliseconds) * CostSmoothing;
+	}
+	Entry.Samples++;
+}
+
+double FMultiTaskCostModel::Estimate(FName TaskClass, int32 WorkSize) const
+{
+	FScopeLock Lock(&Section);
+	const TMap<int32, FCostEntry>* Buckets = Entries.Find(TaskClass);
+	if (!Buckets || Buckets->Num() == 0)
+	{
+		return -1.0;
+	}
+
+	const int32 Bucket = GetSizeBucket(WorkSize);
+	if (const FCostEntry* Entry = Buckets->Find(Bucket))
+	{
+		return Entry->AverageMilliseconds;
+	}
+
+	int32 NearestBucket = INDEX_NONE;
+	for (const TPair<int32, FCostEntry>& Pair : *Buckets)
+	{
+		if (NearestBucket == INDEX_NONE || FMath::Abs(Pair.Key - Bucket) < FMath::Abs(NearestBucket - Bucket))
+		{
+			NearestBucket = Pair.Key;
+		}
+	}
+	return (*Buckets)[NearestBucket].AverageMilliseconds * FMath::Pow(2.0, (double)(Bucket - NearestBucket));
+}
+
+int32 FMultiTaskCostModel::GetSampleCount(FName TaskClass, int32 WorkSize) const
+{
+	FScopeLock Lock(&Section);
+	if (const TMap<int32, FCostEntry>* Buckets = Entries.Find(TaskClass))
+	{
+		if (const FCostEntry* Entry = Buckets->Find(GetSizeBucket(WorkSize)))
+		{
+			return Entry->Samples;
+		}
+	}
+	return 0;
+}
+
+void FMultiTaskCostModel::Reset()
+{
+	FScopeLock Lock(&Section);
+	Entries.Empty();
+}
+
+int32 FMultiTaskCostModel::GetSizeBucket(int32 WorkSize)
+{
+	return WorkSize > 0 ? (int32)FMath::FloorLog2((uint32)WorkSize) + 1 : 0;
+}
@@ -0,0 +1,123 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskGroup.h"
+#include "MultiTaskBase.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+
+UMultiTaskGroup::UMultiTaskGroup()
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		DoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
+		DoneEvent->Trigger();
+	}
+}
+
+void UMultiTaskGroup::AddTask(UMultiTaskBase* Task)
+{
+	if (IsValid(Task) && !Task->HasAnyFlags(RF_BeginDestroyed) && !Task->IsUnreachable())
+	{
+		Task->Group = this;
+	}
+}
+
+void UMultiTaskGroup::WaitAll()
+{
+	// The event is triggered exactly while nothing is outstanding, new work arriving meanwhile sends the caller back to sleep.
+	while (OutstandingWork.GetValue() > 0)
+	{
+		DoneEvent->Wait();
+	}
+}
+
+bool UMultiTaskGroup::IsDone()
+{
+	return OutstandingWork.GetValue() <= 0;
+}
+
+void UMultiTaskGroup::CancelAll()
+{
+	// Sticky until Reset Group, so Tasks added but not started yet are canceled too.
+	if (bCanceled)
+	{
+		return;
+	}
+	bCanceled = true;
+
+	TWeakObjectPtr<UMultiTaskGroup> WeakGroup(this);
+	AsyncTask(ENamedThreads::GameThread, [WeakGroup]()
+	{
+		UMultiTaskGroup* Group = WeakGroup.Get();
+		if (IsValid(Group) && !Group->HasAnyFlags(RF_BeginDestroyed) && !Group->IsUnreachable())
+		{
+			Group->OnCanceled.Broadcast();
+		}
+	});
+}
+
+bool UMultiTaskGroup::IsCanceled()
+{
+	return bCanceled;
+}
+
+void UMultiTaskGroup::ResetGroup()
+{
+	bCanceled = false;
+}
+
+int32 UMultiTaskGroup::GetOutstandingWorkNum()
+{
+	return OutstandingWork.GetValue();
+}
+
+void UMultiTaskGroup::OnWorkStarted()
+{
+	// The event follows the counter transitions under the lock, otherwise a late Reset could outlive the matching Trigger.
+	FScopeLock Lock(&DoneSection);
+	if (OutstandingWork.Increment() == 1)
+	{
+		DoneEvent->Reset();
+	}
+}
+
+void UMultiTaskGroup::OnWorkFinished()
+{
+	{
+		FScopeLock Lock(&DoneSection);
+		if (OutstandingWork.Decrement() > 0)
+		{
+			return;
+		}
+		DoneEvent->Trigger();
+	}
+
+	if (bCanceled)
+	{
+		return;
+	}
+
+	TWeakObjectPtr<UMultiTaskGroup> WeakGroup(this);
+	AsyncTask(ENamedThreads::GameThread, [WeakGroup]()
+	{
+		UMultiTaskGroup* Group = WeakGroup.Get();
+		if (IsValid(Group) && !Group->HasAnyFlags(RF_BeginDestroyed) && !Group->IsUnreachable())
+		{
+			if (Group->IsDone())
+			{
+				Group->OnCompleted.Broadcast();
+			}
+		}
+	});
+}
+
+void UMultiTaskGroup::BeginDestroy()
+{
+	if (DoneEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+		DoneEvent = nullptr;
+	}
+	Super::BeginDestroy();
+}
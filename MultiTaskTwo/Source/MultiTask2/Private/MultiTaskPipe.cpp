@@ -0,0 +1,134 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskPipe.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+void UMultiTaskPipe::Push(FPipeStep&& Step, TUniqueFunction<void()>&& OnDiscarded, const void* Owner)
+{
+	bool bStartNow = false;
+	{
+		FScopeLock Lock(&Section);
+		FQueuedStep& QueuedStep = QueuedSteps.AddDefaulted_GetRef();
+		QueuedStep.Step = MoveTemp(Step);
+		QueuedStep.OnDiscarded = MoveTemp(OnDiscarded);
+		QueuedStep.Owner = Owner;
+		if (!bInFlight)
+		{
+			bInFlight = true;
+			bStartNow = true;
+		}
+	}
+
+	if (bStartNow)
+	{
+		RunNext();
+	}
+}
+
+bool UMultiTaskPipe::IsBusy()
+{
+	FScopeLock Lock(&Section);
+	return bInFlight;
+}
+
+int32 UMultiTaskPipe::DropQueuedWork(const void* Owner)
+{
+	if (Owner == nullptr)
+	{
+		return 0;
+	}
+
+	TArray<FQueuedStep> DroppedSteps;
+	{
+		FScopeLock Lock(&Section);
+		for (int32 StepIndex = 0; StepIndex < QueuedSteps.Num(); ++StepIndex)
+		{
+			if (QueuedSteps[StepIndex].Owner == Owner)
+			{
+				DroppedSteps.Add(MoveTemp(QueuedSteps[StepIndex]));
+				QueuedSteps.RemoveAt(StepIndex--);
+			}
+		}
+	}
+
+	for (FQueuedStep& QueuedStep : DroppedSteps)
+	{
+		DiscardStep(QueuedStep);
+	}
+	return DroppedSteps.Num();
+}
+
+void UMultiTaskPipe::BeginDestroy()
+{
+	// Steps that never got their turn still have to finish whoever waits on them.
+	TArray<FQueuedStep> DroppedSteps;
+	{
+		FScopeLock Lock(&Section);
+		DroppedSteps = MoveTemp(QueuedSteps);
+		QueuedSteps.Empty();
+	}
+
+	for (FQueuedStep& QueuedStep : DroppedSteps)
+	{
+		DiscardStep(QueuedStep);
+	}
+	Super::BeginDestroy();
+}
+
+void UMultiTaskPipe::DiscardStep(FQueuedStep& QueuedStep)
+{
+	if (QueuedStep.OnDiscarded)
+	{
+		QueuedStep.OnDiscarded();
+	}
+}
+
+int32 UMultiTaskPipe::GetQueuedWorkNum()
+{
+	FScopeLock Lock(&Section);
+	return QueuedSteps.Num();
+}
+
+void UMultiTaskPipe::RunNext()
+{
+	enum EStepState : int32 { Running, FinishedInline, Returned };
+
+	// Steps finishing on the stack that launched them (task gone, work rejected or discarded) are chained by the loop,
+	// recursing through the completion callback would grow the stack with every such step.
+	for (;;)
+	{
+		FPipeStep Step;
+		{
+			FScopeLock Lock(&Section);
+			if (QueuedSteps.Num() <= 0)
+			{
+				bInFlight = false;
+				return;
+			}
+			Step = MoveTemp(QueuedSteps[0].Step);
+			QueuedSteps.RemoveAt(0, 1, false);
+		}
+
+		TSharedRef<std::atomic<int32>, ESPMode::ThreadSafe> State = MakeShared<std::atomic<int32>, ESPMode::ThreadSafe>(Running);
+		TWeakObjectPtr<UMultiTaskPipe> WeakPipe(this);
+		Step([WeakPipe, State]()
+		{
+			int32 Expected = Running;
+			if (State->compare_exchange_strong(Expected, FinishedInline))
+			{
+				return;
+			}
+			if (UMultiTaskPipe* Pipe = WeakPipe.Get())
+			{
+				Pipe->RunNext();
+			}
+		});
+
+		int32 Expected = Running;
+		if (State->compare_exchange_strong(Expected, Returned))
+		{
+			// Still running elsewhere, its completion continues the pipe.
+			return;
+		}
+	}
+}
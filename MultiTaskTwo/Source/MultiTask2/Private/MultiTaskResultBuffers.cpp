@@ -0,0 +1,65 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskResultBuffers.h"
+
+void UMultiTaskTransformResultBuffer::Publish(TArray<FTransform>& Data)
+{
+	Swap(Buffer.GetWriteBuffer(), Data);
+	Buffer.Publish();
+}
+
+bool UMultiTaskTransformResultBuffer::Acquire(TArray<FTransform>& Data)
+{
+	if (!Buffer.Acquire())
+	{
+		return false;
+	}
+	Swap(Buffer.GetReadBuffer(), Data);
+	return true;
+}
+
+bool UMultiTaskTransformResultBuffer::HasNewData()
+{
+	return Buffer.HasNewData();
+}
+
+void UMultiTaskFloatResultBuffer::Publish(TArray<float>& Data)
+{
+	Swap(Buffer.GetWriteBuffer(), Data);
+	Buffer.Publish();
+}
+
+bool UMultiTaskFloatResultBuffer::Acquire(TArray<float>& Data)
+{
+	if (!Buffer.Acquire())
+	{
+		return false;
+	}
+	Swap(Buffer.GetReadBuffer(), Data);
+	return true;
+}
+
+bool UMultiTaskFloatResultBuffer::HasNewData()
+{
+	return Buffer.HasNewData();
+}
+
+void UMultiTaskVectorResultBuffer::Publish(TArray<FVector>& Data)
+{
+	Swap(Buffer.GetWriteBuffer(), Data);
+	Buffer.Publish();
+}
+
+bool UMultiTaskVectorResultBuffer::Acquire(TArray<FVector>& Data)
+{
+	if (!Buffer.Acquire())
+	{
+		return false;
+	}
+	Swap(Buffer.GetReadBuffer(), Data);
+	return true;
+}
+
+bool UMultiTaskVectorResultBuffer::HasNewData()
+{
+	return Buffer.HasNewData();
+}
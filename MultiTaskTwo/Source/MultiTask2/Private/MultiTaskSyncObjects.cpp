@@ -0,0 +1,182 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiTaskSyncObjects.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+// Every blocked thread parks on its own event. The event is registered under the object's lock
+// and only waited on after the lock is released, a trigger arriving in between is not lost.
+static FEvent* AddWaiter(TArray<FEvent*>& Waiters)
+{
+	FEvent* WaitEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Waiters.Add(WaitEvent);
+	return WaitEvent;
+}
+
+static void ParkOn(FEvent* WaitEvent)
+{
+	WaitEvent->Wait();
+	FPlatformProcess::ReturnSynchEventToPool(WaitEvent);
+}
+
+static void WakeAll(TArray<FEvent*>& Waiters)
+{
+	for (FEvent* WaitEvent : Waiters)
+	{
+		WaitEvent->Trigger();
+	}
+	Waiters.Empty();
+}
+
+void UMultiTaskBarrier::Init(int32 InParticipants)
+{
+	FScopeLock Lock(&Section);
+	Participants = FMath::Max(InParticipants, 1);
+	Arrived = 0;
+}
+
+bool UMultiTaskBarrier::ArriveAndWait()
+{
+	FEvent* WaitEvent = nullptr;
+	{
+		FScopeLock Lock(&Section);
+		Arrived++;
+		if (Arrived >= Participants)
+		{
+			Arrived = 0;
+			WakeAll(Waiters);
+			return true;
+		}
+		WaitEvent = AddWaiter(Waiters);
+	}
+	ParkOn(WaitEvent);
+	return false;
+}
+
+int32 UMultiTaskBarrier::GetParticipants()
+{
+	FScopeLock Lock(&Section);
+	return Participants;
+}
+
+void UMultiTaskBarrier::BeginDestroy()
+{
+	{
+		FScopeLock Lock(&Section);
+		WakeAll(Waiters);
+	}
+	Super::BeginDestroy();
+}
+
+void UMultiTaskLatch::Init(int32 InCount)
+{
+	FScopeLock Lock(&Section);
+	Count = FMath::Max(InCount, 0);
+}
+
+void UMultiTaskLatch::CountDown(int32 Amount)
+{
+	FScopeLock Lock(&Section);
+	if (Count <= 0)
+	{
+		return;
+	}
+	Count = FMath::Max(Count - FMath::Max(Amount, 0), 0);
+	if (Count == 0)
+	{
+		WakeAll(Waiters);
+	}
+}
+
+void UMultiTaskLatch::Wait()
+{
+	FEvent* WaitEvent = nullptr;
+	{
+		FScopeLock Lock(&Section);
+		if (Count <= 0)
+		{
+			return;
+		}
+		WaitEvent = AddWaiter(Waiters);
+	}
+	ParkOn(WaitEvent);
+}
+
+bool UMultiTaskLatch::IsReleased()
+{
+	FScopeLock Lock(&Section);
+	return Count <= 0;
+}
+
+void UMultiTaskLatch::BeginDestroy()
+{
+	{
+		FScopeLock Lock(&Section);
+		Count = 0;
+		WakeAll(Waiters);
+	}
+	Super::BeginDestroy();
+}
+
+void UMultiTaskSemaphore::Init(int32 InitialCount)
+{
+	FScopeLock Lock(&Section);
+	Available = FMath::Max(InitialCount, 0);
+}
+
+void UMultiTaskSemaphore::Acquire()
+{
+	FEvent* WaitEvent = nullptr;
+	{
+		FScopeLock Lock(&Section);
+		if (Available > 0)
+		{
+			Available--;
+			return;
+		}
+		WaitEvent = AddWaiter(Waiters);
+	}
+	ParkOn(WaitEvent);
+}
+
+bool UMultiTaskSemaphore::TryAcquire()
+{
+	FScopeLock Lock(&Section);
+	if (Available > 0)
+	{
+		Available--;
+		return true;
+	}
+	return false;
+}
+
+void UMultiTaskSemaphore::Release(int32 Count)
+{
+	FScopeLock Lock(&Section);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (Waiters.Num() > 0)
+		{
+			Waiters[0]->Trigger();
+			Waiters.RemoveAt(0, 1, false);
+		}
+		else {
+			Available++;
+		}
+	}
+}
+
+int32 UMultiTaskSemaphore::GetAvailableCount()
+{
+	FScopeLock Lock(&Section);
+	return Available;
+}
+
+void UMultiTaskSemaphore::BeginDestroy()
+{
+	{
+		FScopeLock Lock(&Section);
+		WakeAll(Waiters);
+	}
+	Super::BeginDestroy();
+}
@@ -1,5 +1,43 @@
 // Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
 #include "MultiTaskThreadPool.h"
+#include "RenderCore.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Optional.h"
+#include "Algo/StableSort.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CoreDelegates.h"
+
+class FMultiTaskPoolWork : public IQueuedWork
+{
+	UMultiTaskThreadPool* Owner;
+	FMultiTaskPoolJob Job;
+public:
+	FMultiTaskPoolWork(UMultiTaskThreadPool* InOwner, FMultiTaskPoolJob&& InJob)
+		: Owner(InOwner)
+		, Job(MoveTemp(InJob))
+	{}
+
+	virtual void DoThreadedWork() override
+	{
+		if (Job.Body)
+		{
+			Job.Body();
+		}
+		Job.Promise.SetValue();
+		Owner->OnWorkFinished();
+		delete this;
+	}
+
+	virtual void Abandon() override
+	{
+		// Never executed, handled like work dropped from the queue.
+		UMultiTaskThreadPool::DiscardJob(Job);
+		Owner->OnWorkAbandoned();
+		delete this;
+	}
+};
 
 bool UMultiTaskThreadPool::Create(uint32 InNumQueuedThreads, uint32 StackSize, EThreadPriority ThreadPriority, const FString Name)
 {
@@ -7,6 +45,15 @@ bool UMultiTaskThreadPool::Create(uint32 InNumQueuedThreads, uint32 StackSize, E
 	const bool bResult = Obj->Create(InNumQueuedThreads, StackSize, ThreadPriority, *Name);
 	if (bResult)
 	{
+		ActiveThreadsLimit.Set(Obj->GetNumThreads());
+		if (!QueueSpaceEvent)
+		{
+			QueueSpaceEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		}
+		if (!EndFrameHandle.IsValid())
+		{
+			EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UMultiTaskThreadPool::OnEndFrame);
+		}
 		return true;
 	}
 	else {
@@ -15,6 +62,201 @@ bool UMultiTaskThreadPool::Create(uint32 InNumQueuedThreads, uint32 StackSize, E
 	}
 }
 
+void UMultiTaskThreadPool::SetThreadsAffinity(uint64 AffinityMask)
+{
+	const int32 NumThreads = GetThreadsNum();
+	if (AffinityMask == 0 || NumThreads <= 0)
+	{
+		return;
+	}
+
+	// Every work item waits until all of them started, so each worker thread executes exactly one.
+	FThreadSafeCounter StartedCount;
+	FEvent* AllStartedEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	TArray<TFuture<void>> Futures;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		Futures.Add(AsyncPool(*Obj, [AffinityMask, NumThreads, &StartedCount, AllStartedEvent]()
+			{
+				FPlatformProcess::SetThreadAffinityMask(AffinityMask);
+				if (StartedCount.Increment() == NumThreads)
+				{
+					AllStartedEvent->Trigger();
+				}
+				AllStartedEvent->Wait(1000);
+			}));
+	}
+
+	for (TFuture<void>& Future : Futures)
+	{
+		Future.Wait();
+	}
+	FPlatformProcess::ReturnSynchEventToPool(AllStartedEvent);
+}
+
+EThreadPriority UMultiTaskThreadPool::ToThreadPriority(EMultiTaskThreadPriority ThreadPriority)
+{
+	switch (ThreadPriority)
+	{
+	case EMultiTaskThreadPriority::AboveNormal:
+		return EThreadPriority::TPri_AboveNormal;
+	case EMultiTaskThreadPriority::BelowNormal:
+		return EThreadPriority::TPri_BelowNormal;
+	case EMultiTaskThreadPriority::Highest:
+		return EThreadPriority::TPri_Highest;
+	case EMultiTaskThreadPriority::Lowest:
+		return EThreadPriority::TPri_Lowest;
+	case EMultiTaskThreadPriority::SlightlyBelowNormal:
+		return EThreadPriority::TPri_SlightlyBelowNormal;
+	case EMultiTaskThreadPriority::TimeCritical:
+		return EThreadPriority::TPri_TimeCritical;
+	case EMultiTaskThreadPriority::Normal:
+	default:
+		return EThreadPriority::TPri_Normal;
+	}
+}
+
+TFuture<void> UMultiTaskThreadPool::Launch(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, EMultiTaskWorkPriority Priority, double ExpectedCost,
+	FName CoalesceKey, const void* Owner, TUniqueFunction<void()>&& OnDiscarded)
+{
+	FMultiTaskPoolJob Job;
+	Job.Body = MoveTemp(Body);
+	Job.Promise = TPromise<void>(MoveTemp(OnCompleted));
+	Job.ExpectedCost = ExpectedCost;
+	Job.OnDiscarded = MoveTemp(OnDiscarded);
+	Job.CoalesceKey = CoalesceKey;
+	Job.Owner = Owner;
+	return Enqueue(MoveTemp(Job), Priority, true);
+}
+
+TFuture<void> UMultiTaskThreadPool::TryLaunch(TUniqueFunction<void()>&& Body, EMultiTaskWorkPriority Priority, TUniqueFunction<void()>&& OnDiscarded)
+{
+	FMultiTaskPoolJob Job;
+	Job.Body = MoveTemp(Body);
+	Job.OnDiscarded = MoveTemp(OnDiscarded);
+	return Enqueue(MoveTemp(Job), Priority, false);
+}
+
+TFuture<void> UMultiTaskThreadPool::Enqueue(FMultiTaskPoolJob&& Job, EMultiTaskWorkPriority Priority, bool bAllowWait)
+{
+	const FName CoalesceKey = Job.CoalesceKey;
+	const void* Owner = Job.Owner;
+	TFuture<void> Future = Job.Promise.GetFuture();
+
+	if (bBatchGameThreadWork && !bFrameBatchOpen && IsInGameThread())
+	{
+		bFrameBatchOpen = true;
+		BeginBatch();
+	}
+
+	// The governor and the dispatching of finished work both rely on the Game Thread, it must never wait for room.
+	const bool bBlock = QueuePolicy == EMultiTaskQueuePolicy::Block && bAllowWait && !IsInGameThread();
+	if (MaxQueuedWork > 0 && bBlock)
+	{
+		// Work held by an open batch is only dispatched at End Batch, waiting for it would never return.
+		bool bFull = true;
+		while (bFull)
+		{
+			{
+				FScopeLock Lock(&QueueSection);
+				bFull = BatchDepth == 0 && GetQueuedWorkNum_Locked() >= MaxQueuedWork;
+			}
+			if (bFull)
+			{
+				if (!Obj.IsValid() || !QueueSpaceEvent)
+				{
+					break;
+				}
+				Dispatch();
+				QueueSpaceEvent->Wait(10);
+			}
+		}
+	}
+
+	TOptional<FMultiTaskPoolJob> ReplacedJob;
+	bool bReplaced = false;
+	bool bRejected = false;
+	{
+		FScopeLock Lock(&QueueSection);
+		// On Game Thread Block falls back to Reject, except inside a batch which is dispatched as a whole at End Batch.
+		const bool bRejectWhenFull = QueuePolicy != EMultiTaskQueuePolicy::Block || (!bBlock && BatchDepth == 0);
+		if (MaxQueuedWork > 0 && bRejectWhenFull && GetQueuedWorkNum_Locked() >= MaxQueuedWork)
+		{
+			if (QueuePolicy == EMultiTaskQueuePolicy::ReplaceOldest && !CoalesceKey.IsNone())
+			{
+				bReplaced = RemoveOldestWithKey_Locked(CoalesceKey, Owner, ReplacedJob);
+			}
+			bRejected = !bReplaced;
+		}
+
+		if (!bRejected)
+		{
+			QueuedWork[static_cast<int32>(Priority)].Add(MoveTemp(Job));
+			QueuedWorkCount[static_cast<int32>(Priority)].Increment();
+			PeakQueuedWork = FMath::Max(PeakQueuedWork, GetQueuedWorkNum_Locked());
+		}
+	}
+
+	if (bReplaced)
+	{
+		ReplacedWork.Increment();
+		DiscardJob(ReplacedJob.GetValue());
+	}
+	if (bRejected)
+	{
+		RejectedWork.Increment();
+		DiscardJob(Job);
+		return Future;
+	}
+
+	Dispatch();
+	return Future;
+}
+
+void UMultiTaskThreadPool::BeginBatch()
+{
+	FScopeLock Lock(&QueueSection);
+	if (BatchDepth == 0)
+	{
+		for (int32 PriorityIndex = 0; PriorityIndex < NumWorkPriorities; ++PriorityIndex)
+		{
+			BatchStart[PriorityIndex] = QueuedWork[PriorityIndex].Num();
+		}
+	}
+	BatchDepth++;
+}
+
+void UMultiTaskThreadPool::EndBatch()
+{
+	{
+		FScopeLock Lock(&QueueSection);
+		if (BatchDepth <= 0)
+		{
+			return;
+		}
+		BatchDepth--;
+		if (BatchDepth > 0)
+		{
+			return;
+		}
+
+		for (int32 PriorityIndex = 0; PriorityIndex < NumWorkPriorities; ++PriorityIndex)
+		{
+			TArray<FMultiTaskPoolJob>& Queue = QueuedWork[PriorityIndex];
+			const int32 Start = FMath::Min(BatchStart[PriorityIndex], Queue.Num());
+			if (Queue.Num() - Start > 1)
+			{
+				// Unknown costs sort last, equal costs keep their launch order.
+				Algo::StableSort(MakeArrayView(Queue.GetData() + Start, Queue.Num() - Start), [](const FMultiTaskPoolJob& A, const FMultiTaskPoolJob& B)
+					{
+						return A.ExpectedCost > B.ExpectedCost;
+					});
+			}
+		}
+	}
+	Dispatch();
+}
+
 int32 UMultiTaskThreadPool::GetThreadsNum()
 {
 	if (Obj.IsValid())
@@ -23,3 +265,365 @@ int32 UMultiTaskThreadPool::GetThreadsNum()
 	}
 	return 0;
 }
+
+int32 UMultiTaskThreadPool::GetQueuedWorkNum()
+{
+	FScopeLock Lock(&QueueSection);
+	return GetQueuedWorkNum_Locked();
+}
+
+int32 UMultiTaskThreadPool::GetQueuedWorkNum_Locked() const
+{
+	int32 Count = 0;
+	for (int32 PriorityIndex = 0; PriorityIndex < NumWorkPriorities; ++PriorityIndex)
+	{
+		Count += QueuedWork[PriorityIndex].Num();
+	}
+	return Count;
+}
+
+bool UMultiTaskThreadPool::RemoveOldestWithKey_Locked(FName CoalesceKey, const void* Owner, TOptional<FMultiTaskPoolJob>& OutJob)
+{
+	// Lowest priority first, stale low priority work is the cheapest to give up.
+	for (int32 PriorityIndex = NumWorkPriorities - 1; PriorityIndex >= 0; --PriorityIndex)
+	{
+		TArray<FMultiTaskPoolJob>& Queue = QueuedWork[PriorityIndex];
+		for (int32 JobIndex = 0; JobIndex < Queue.Num(); ++JobIndex)
+		{
+			if (Queue[JobIndex].CoalesceKey == CoalesceKey && Queue[JobIndex].Owner != Owner)
+			{
+				OutJob.Emplace(MoveTemp(Queue[JobIndex]));
+				Queue.RemoveAt(JobIndex);
+				QueuedWorkCount[PriorityIndex].Decrement();
+				if (BatchDepth > 0 && JobIndex < BatchStart[PriorityIndex])
+				{
+					BatchStart[PriorityIndex]--;
+				}
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+int32 UMultiTaskThreadPool::DropQueuedWork(const void* Owner)
+{
+	if (Owner == nullptr)
+	{
+		return 0;
+	}
+
+	TArray<FMultiTaskPoolJob> DroppedWork;
+	{
+		FScopeLock Lock(&QueueSection);
+		for (int32 PriorityIndex = 0; PriorityIndex < NumWorkPriorities; ++PriorityIndex)
+		{
+			TArray<FMultiTaskPoolJob>& Queue = QueuedWork[PriorityIndex];
+			for (int32 JobIndex = Queue.Num() - 1; JobIndex >= 0; --JobIndex)
+			{
+				if (Queue[JobIndex].Owner == Owner)
+				{
+					DroppedWork.Add(MoveTemp(Queue[JobIndex]));
+					Queue.RemoveAt(JobIndex);
+					QueuedWorkCount[PriorityIndex].Decrement();
+					if (BatchDepth > 0 && JobIndex < BatchStart[PriorityIndex])
+					{
+						BatchStart[PriorityIndex]--;
+					}
+				}
+			}
+		}
+	}
+
+	if (DroppedWork.Num() > 0 && QueueSpaceEvent)
+	{
+		QueueSpaceEvent->Trigger();
+	}
+	for (FMultiTaskPoolJob& Job : DroppedWork)
+	{
+		DiscardJob(Job);
+	}
+	return DroppedWork.Num();
+}
+
+void UMultiTaskThreadPool::DiscardJob(FMultiTaskPoolJob& Job)
+{
+	if (Job.OnDiscarded)
+	{
+		Job.OnDiscarded();
+	}
+	Job.Promise.SetValue();
+}
+
+int32 UMultiTaskThreadPool::GetQueuedWorkNumForPriority(EMultiTaskWorkPriority Priority)
+{
+	return QueuedWorkCount[static_cast<int32>(Priority)].GetValue();
+}
+
+int32 UMultiTaskThreadPool::GetPeakQueuedWorkNum()
+{
+	FScopeLock Lock(&QueueSection);
+	return PeakQueuedWork;
+}
+
+int32 UMultiTaskThreadPool::GetRejectedWorkNum()
+{
+	return RejectedWork.GetValue();
+}
+
+int32 UMultiTaskThreadPool::GetReplacedWorkNum()
+{
+	return ReplacedWork.GetValue();
+}
+
+void UMultiTaskThreadPool::ResetQueueMetrics()
+{
+	FScopeLock Lock(&QueueSection);
+	PeakQueuedWork = GetQueuedWorkNum_Locked();
+	RejectedWork.Reset();
+	ReplacedWork.Reset();
+}
+
+bool UMultiTaskThreadPool::HasWaitingWork(EMultiTaskWorkPriority Priority) const
+{
+	for (int32 PriorityIndex = 0; PriorityIndex < static_cast<int32>(Priority); ++PriorityIndex)
+	{
+		if (QueuedWorkCount[PriorityIndex].GetValue() > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UMultiTaskThreadPool::RunWaitingWork(EMultiTaskWorkPriority Priority)
+{
+	bool bExecuted = false;
+	while (HasWaitingWork(Priority))
+	{
+		// Only built once an item is taken, another worker may have dispatched it since the lock free check.
+		TOptional<FMultiTaskPoolJob> Job;
+		{
+			FScopeLock Lock(&QueueSection);
+			for (int32 PriorityIndex = 0; PriorityIndex < static_cast<int32>(Priority); ++PriorityIndex)
+			{
+				// Work launched inside an open batch waits for End Batch.
+				const int32 Available = BatchDepth > 0 ? FMath::Min(BatchStart[PriorityIndex], QueuedWork[PriorityIndex].Num()) : QueuedWork[PriorityIndex].Num();
+				if (Available > 0)
+				{
+					Job.Emplace(MoveTemp(QueuedWork[PriorityIndex][0]));
+					QueuedWork[PriorityIndex].RemoveAt(0, 1, false);
+					QueuedWorkCount[PriorityIndex].Decrement();
+					if (BatchDepth > 0)
+					{
+						BatchStart[PriorityIndex]--;
+					}
+					break;
+				}
+			}
+		}
+
+		if (!Job.IsSet())
+		{
+			break;
+		}
+		if (QueueSpaceEvent)
+		{
+			QueueSpaceEvent->Trigger();
+		}
+
+		// The calling worker already counts as active, so the job runs within the same slot.
+		if (Job->Body)
+		{
+			Job->Body();
+		}
+		Job->Promise.SetValue();
+		bExecuted = true;
+	}
+	return bExecuted;
+}
+
+void UMultiTaskThreadPool::EnableFrameGovernor(float TargetFrameTimeMs, int32 MinThreads, bool bPauseLowPriority)
+{
+	TargetFrameTime = FMath::Max(TargetFrameTimeMs, 1.0f);
+	MinActiveThreads = FMath::Max(MinThreads, 0);
+	bPauseLowPriorityWork = bPauseLowPriority;
+	HeadroomFrameCount = 0;
+	bGovernorEnabled = true;
+}
+
+void UMultiTaskThreadPool::DisableFrameGovernor()
+{
+	bGovernorEnabled = false;
+	bThrottled = false;
+	HeadroomFrameCount = 0;
+	ActiveThreadsLimit.Set(GetThreadsNum());
+	Dispatch();
+}
+
+int32 UMultiTaskThreadPool::GetActiveThreadsLimit()
+{
+	return ActiveThreadsLimit.GetValue();
+}
+
+bool UMultiTaskThreadPool::IsThrottled()
+{
+	return bThrottled;
+}
+
+void UMultiTaskThreadPool::BeginDestroy()
+{
+	if (EndFrameHandle.IsValid())
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		EndFrameHandle.Reset();
+	}
+	OnEndFrame();
+	AbandonQueuedWork();
+	// In flight work reports back to this object, the pool must be torn down while the queue members are still alive.
+	if (Obj.IsValid())
+	{
+		Obj->Destroy();
+		Obj.Reset();
+	}
+	if (QueueSpaceEvent)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(QueueSpaceEvent);
+		QueueSpaceEvent = nullptr;
+	}
+	Super::BeginDestroy();
+}
+
+void UMultiTaskThreadPool::OnWorkFinished()
+{
+	ActiveWork.Decrement();
+	Dispatch();
+}
+
+void UMultiTaskThreadPool::OnWorkAbandoned()
+{
+	ActiveWork.Decrement();
+}
+
+void UMultiTaskThreadPool::OnEndFrame()
+{
+	if (bFrameBatchOpen)
+	{
+		bFrameBatchOpen = false;
+		EndBatch();
+	}
+}
+
+void UMultiTaskThreadPool::Tick(float DeltaTime)
+{
+	const int32 NumThreads = GetThreadsNum();
+	if (NumThreads <= 0)
+	{
+		return;
+	}
+
+	const float GameThreadTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	const float RenderThreadTime = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	const float FrameTime = FMath::Max(GameThreadTime, RenderThreadTime);
+
+	int32 Limit = ActiveThreadsLimit.GetValue();
+	const int32 MinLimit = FMath::Clamp(MinActiveThreads, 0, NumThreads);
+
+	if (FrameTime > TargetFrameTime)
+	{
+		HeadroomFrameCount = 0;
+		Limit = FMath::Max(MinLimit, Limit - 1);
+	}
+	else if (FrameTime < TargetFrameTime * HeadroomRatio)
+	{
+		HeadroomFrameCount++;
+		if (HeadroomFrameCount >= RecoveryFrames)
+		{
+			HeadroomFrameCount = 0;
+			Limit = FMath::Min(NumThreads, Limit + 1);
+		}
+	}
+	else {
+		HeadroomFrameCount = 0;
+	}
+
+	ActiveThreadsLimit.Set(Limit);
+	bThrottled = Limit < NumThreads;
+	Dispatch();
+}
+
+bool UMultiTaskThreadPool::IsTickable() const
+{
+	return bGovernorEnabled && Obj.IsValid();
+}
+
+bool UMultiTaskThreadPool::IsTickableWhenPaused() const
+{
+	return true;
+}
+
+TStatId UMultiTaskThreadPool::GetStatId() const
+{
+	return TStatId();
+}
+
+void UMultiTaskThreadPool::Dispatch()
+{
+	if (!Obj.IsValid())
+	{
+		AbandonQueuedWork();
+		return;
+	}
+
+	TArray<FMultiTaskPoolJob> ReadyWork;
+	{
+		FScopeLock Lock(&QueueSection);
+		const int32 LastPriority = (bThrottled && bPauseLowPriorityWork) ? static_cast<int32>(EMultiTaskWorkPriority::Normal) : (NumWorkPriorities - 1);
+		for (int32 PriorityIndex = 0; PriorityIndex <= LastPriority; ++PriorityIndex)
+		{
+			// Work launched inside an open batch waits for End Batch, the work queued before it keeps flowing.
+			int32 Available = BatchDepth > 0 ? FMath::Min(BatchStart[PriorityIndex], QueuedWork[PriorityIndex].Num()) : QueuedWork[PriorityIndex].Num();
+			while (Available > 0 && ActiveWork.GetValue() < ActiveThreadsLimit.GetValue())
+			{
+				ActiveWork.Increment();
+				ReadyWork.Add(MoveTemp(QueuedWork[PriorityIndex][0]));
+				QueuedWork[PriorityIndex].RemoveAt(0, 1, false);
+				QueuedWorkCount[PriorityIndex].Decrement();
+				Available--;
+				if (BatchDepth > 0)
+				{
+					BatchStart[PriorityIndex]--;
+				}
+			}
+		}
+	}
+
+	if (ReadyWork.Num() > 0 && QueueSpaceEvent)
+	{
+		QueueSpaceEvent->Trigger();
+	}
+
+	for (FMultiTaskPoolJob& Job : ReadyWork)
+	{
+		Obj->AddQueuedWork(new FMultiTaskPoolWork(this, MoveTemp(Job)));
+	}
+}
+
+void UMultiTaskThreadPool::AbandonQueuedWork()
+{
+	TArray<FMultiTaskPoolJob> AbandonedWork;
+	{
+		FScopeLock Lock(&QueueSection);
+		for (int32 PriorityIndex = 0; PriorityIndex < NumWorkPriorities; ++PriorityIndex)
+		{
+			AbandonedWork.Append(MoveTemp(QueuedWork[PriorityIndex]));
+			QueuedWork[PriorityIndex].Empty();
+			QueuedWorkCount[PriorityIndex].Reset();
+		}
+	}
+
+	for (FMultiTaskPoolJob& Job : AbandonedWork)
+	{
+		DiscardJob(Job);
+	}
+}
@@ -70,20 +70,6 @@ bool UDelaunayTriangulation2DTask::Start()
 
     UDelaunayTriangulation2DTask* Worker = this;
 
-    EAsyncExecution AsyncType = EAsyncExecution::ThreadPool;
-    switch (ExecutionType)
-    {
-    case ETaskExecutionType::TaskGraph:
-        AsyncType = EAsyncExecution::TaskGraph;
-        break;
-    case ETaskExecutionType::Thread:
-        AsyncType = EAsyncExecution::Thread;
-        break;
-    case ETaskExecutionType::ThreadPool:
-        AsyncType = EAsyncExecution::ThreadPool;
-        break;
-    }
-
     TFunction<void()> BodyFunc = [Worker]()
     {
         if (IsValid(Worker) && !Worker->HasAnyFlags(RF_BeginDestroyed) && !Worker->IsUnreachable())
@@ -107,16 +93,19 @@ bool UDelaunayTriangulation2DTask::Start()
     };
 
     Tasks.SetNumZeroed(1);
-    if (AsyncType == EAsyncExecution::ThreadPool && ThreadPool && ThreadPool->GetThreadsNum() > 0)
-    {
-        Tasks[0] = AsyncPool(ThreadPool->Obj.ToSharedRef().Get(), TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
-    }
-    else {
-        Tasks[0] = Async(AsyncType, TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
-    }
+    Tasks[0] = LaunchWork(TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
     return true;
 }
 
+int32 UDelaunayTriangulation2DTask::GetWorkSize() const
+{
+	if (WorkSize > 0)
+	{
+		return WorkSize;
+	}
+	return Vertices.Num();
+}
+
 void UDelaunayTriangulation2DTask::TaskBody_Implementation()
 {
 	Triangles.Empty();
@@ -5,6 +5,7 @@
 #include "MultiTask2UtilitiesLibrary.h"
 #include "MultiTask2VoxelLibrary.h"
 #include "MultiTask2MeshSimplifier.h"
+#include "MultiTaskBuffers.h"
 #include "RenderUtils.h"
 static const FIntVector DMCOffSets[8] =
 {
@@ -56,19 +57,12 @@ bool UGenerateMarchingCubesTask::Start()
 
     UGenerateMarchingCubesTask* Worker = this;
 
-    EAsyncExecution AsyncType = EAsyncExecution::ThreadPool;
-    switch (ExecutionType)
+    // The simplifier polls the progress object on every collapse, which doubles as its yield point.
+    Progress.CancelF = [Worker]()
     {
-    case ETaskExecutionType::TaskGraph:
-        AsyncType = EAsyncExecution::TaskGraph;
-        break;
-    case ETaskExecutionType::Thread:
-        AsyncType = EAsyncExecution::Thread;
-        break;
-    case ETaskExecutionType::ThreadPool:
-        AsyncType = EAsyncExecution::ThreadPool;
-        break;
-    }
+        Worker->YieldToPendingWork();
+        return Worker->IsCanceled();
+    };
 
     TFunction<void()> BodyFunc = [Worker]()
     {
@@ -93,13 +87,7 @@ bool UGenerateMarchingCubesTask::Start()
     };
 
     Tasks.SetNumZeroed(1);
-    if (AsyncType == EAsyncExecution::ThreadPool && ThreadPool && ThreadPool->GetThreadsNum() > 0)
-    {
-        Tasks[0] = AsyncPool(ThreadPool->Obj.ToSharedRef().Get(), TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
-    }
-    else {
-        Tasks[0] = Async(AsyncType, TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
-    }
+    Tasks[0] = LaunchWork(TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
     return true;
 }
 
@@ -109,6 +97,15 @@ void UGenerateMarchingCubesTask::Cancel()
 	Progress.CancelF = []() { return true; };
 }
 
+int32 UGenerateMarchingCubesTask::GetWorkSize() const
+{
+	if (WorkSize > 0)
+	{
+		return WorkSize;
+	}
+	return Settings.Units.X * Settings.Units.Y * Settings.Units.Z;
+}
+
 void UGenerateMarchingCubesTask::TaskBody_Implementation()
 {
 	if (bGenerateMeshData)
@@ -141,6 +138,7 @@ void UGenerateMarchingCubesTask::GenerateVoxelData()
 		{
 			return;
 		}
+		YieldToPendingWork();
 		const int32 X = (CurrentIndex % VSizeX) + Step;
 		const int32 Y = ((CurrentIndex / VSizeX) % VSizeY) + Step;
 		const int32 Z = (CurrentIndex / (VSizeX * VSizeY)) + Step;
@@ -274,6 +272,7 @@ void UGenerateMarchingCubesTask::ConvertVoxelDataToMeshData()
 				{
 					return;
 				}
+				YieldToPendingWork();
 
 				const FVector v0 = FVector(VoxelData.Data.GetVertex(Triangle[0]));
 				const FVector v1 = FVector(VoxelData.Data.GetVertex(Triangle[1]));
@@ -324,6 +323,7 @@ void UGenerateMarchingCubesTask::ConvertVoxelDataToMeshData()
 				{
 					return;
 				}
+				YieldToPendingWork();
 
 				const FVector Coords = FVector(VoxelCoordinates);
 
@@ -1090,4 +1090,16 @@ void UGenerateMarchingCubesTask::MakePerpVectors(const FVector& Normal, FVector&
 		OutPerp1.Y = B;
 		OutPerp1.Z = -Normal.X;
 	}
-}
\ No newline at end of file
+}
+
+void FVoxelDataToMeshDataTaskAction::MoveMeshDataToOutput(UGenerateMarchingCubesTask* LocalTask)
+{
+	if (MeshBuffer)
+	{
+		MeshBuffer->Buffer = TMultiTaskImmutableBuffer<FMarchingCubesMeshData>(MoveTemp(LocalTask->MeshData));
+	}
+	else if (MeshData) {
+		*MeshData = MoveTemp(LocalTask->MeshData);
+	}
+	LocalTask->MeshData.Empty();
+}
@@ -3,7 +3,6 @@
 
 UMultiFrameAsyncTask::UMultiFrameAsyncTask()
 {
-	bIsTickable = true;
 }
 
 UMultiFrameAsyncTask::~UMultiFrameAsyncTask()
@@ -12,10 +11,12 @@ UMultiFrameAsyncTask::~UMultiFrameAsyncTask()
 
 bool UMultiFrameAsyncTask::Start()
 {
-	if (IterationsPerTick >= 1 && Delay >= 0.0f)
+	if (IterationsPerTick >= 1 && Delay >= 0.0f && TimeBudget >= 0.0f)
 	{
 		TimeRemaining = 0.0f;
 		bStarted = true;
+		EnterGroup();
+		Schedule();
 		return true;
 	}
 	return false;
@@ -34,29 +35,16 @@ bool UMultiFrameAsyncTask::IsRunning()
 	return false;
 }
 
-void UMultiFrameAsyncTask::Tick(float DeltaTime)
+bool UMultiFrameAsyncTask::HasPendingIterations() const
 {
-	if (bStarted && !IsCanceled())
+	return true;
+}
+
+void UMultiFrameAsyncTask::ExecuteIteration()
+{
+	TaskBody();
+	if (TaskDelegate.IsBound())
 	{
-		TimeRemaining -= DeltaTime;
-		if (TimeRemaining <= 0.0f)
-		{
-			TimeRemaining = Delay;
-			for (int32 CurrentIt = 0; CurrentIt < IterationsPerTick; CurrentIt++)
-			{
-				if (IsCanceled())
-				{
-					break;
-				}
-				else {
-					TaskBody();
-					if (TaskDelegate.IsBound())
-					{
-						TaskDelegate.Broadcast();
-					}
-				}
-			}
-		}
+		TaskDelegate.Broadcast();
 	}
-	//UMultiTaskBase::Tick(DeltaTime);
 }
@@ -0,0 +1,210 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiFrameGridWalker.h"
+
+void FMultiFrameGridWalker::Reset(EMultiFrameLoopOrder InOrder, const FIntVector& InSize, int32 InTileSize)
+{
+	Order = InOrder;
+	Size = InSize;
+	Cell = FIntVector(0);
+	bDone = Size.X <= 0 || Size.Y <= 0 || Size.Z <= 0;
+	TileSize = FMath::Max(InTileSize, 1);
+	TileOrigin = FIntVector(0);
+	MortonBits.Reset();
+	HilbertSide = 1;
+	HilbertIndex = 0;
+	HilbertOrigin = FIntVector(0);
+
+	if (bDone)
+	{
+		return;
+	}
+
+	if (Order == EMultiFrameLoopOrder::Morton)
+	{
+		// Interleave the bits of every axis while it has some left, so thin grids do not walk a cube of empty codes.
+		const int32 AxisBits[3] = {
+			(int32)FMath::CeilLogTwo((uint32)Size.X),
+			(int32)FMath::CeilLogTwo((uint32)Size.Y),
+			(int32)FMath::CeilLogTwo((uint32)Size.Z)
+		};
+		const int32 MaxBits = FMath::Max3(AxisBits[0], AxisBits[1], AxisBits[2]);
+		for (int32 Bit = 0; Bit < MaxBits; Bit++)
+		{
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				if (Bit < AxisBits[Axis])
+				{
+					MortonBits.Add((uint8)((Axis << 5) | Bit));
+				}
+			}
+		}
+	}
+	else if (Order == EMultiFrameLoopOrder::Hilbert)
+	{
+		HilbertSide = (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Min(Size.X, Size.Y));
+	}
+}
+
+void FMultiFrameGridWalker::Next()
+{
+	if (bDone)
+	{
+		return;
+	}
+
+	switch (Order)
+	{
+	case EMultiFrameLoopOrder::Tiled:
+		NextTiled();
+		break;
+	case EMultiFrameLoopOrder::Morton:
+		NextMorton();
+		break;
+	case EMultiFrameLoopOrder::Hilbert:
+		NextHilbert();
+		break;
+	default:
+		NextLinear();
+		break;
+	}
+}
+
+void FMultiFrameGridWalker::NextLinear()
+{
+	if (++Cell.X < Size.X)
+	{
+		return;
+	}
+	Cell.X = 0;
+	if (++Cell.Y < Size.Y)
+	{
+		return;
+	}
+	Cell.Y = 0;
+	if (++Cell.Z >= Size.Z)
+	{
+		bDone = true;
+	}
+}
+
+void FMultiFrameGridWalker::NextTiled()
+{
+	const FIntVector TileEnd(
+		FMath::Min(TileOrigin.X + TileSize, Size.X),
+		FMath::Min(TileOrigin.Y + TileSize, Size.Y),
+		FMath::Min(TileOrigin.Z + TileSize, Size.Z));
+
+	if (++Cell.X < TileEnd.X)
+	{
+		return;
+	}
+	Cell.X = TileOrigin.X;
+	if (++Cell.Y < TileEnd.Y)
+	{
+		return;
+	}
+	Cell.Y = TileOrigin.Y;
+	if (++Cell.Z < TileEnd.Z)
+	{
+		return;
+	}
+
+	TileOrigin.X += TileSize;
+	if (TileOrigin.X >= Size.X)
+	{
+		TileOrigin.X = 0;
+		TileOrigin.Y += TileSize;
+		if (TileOrigin.Y >= Size.Y)
+		{
+			TileOrigin.Y = 0;
+			TileOrigin.Z += TileSize;
+			if (TileOrigin.Z >= Size.Z)
+			{
+				bDone = true;
+				return;
+			}
+		}
+	}
+	Cell = TileOrigin;
+}
+
+void FMultiFrameGridWalker::NextMorton()
+{
+	do
+	{
+		// Add one to the interleaved code: clear the trailing set bits, then set the first clear one.
+		bool bCarry = true;
+		for (const uint8 MortonBit : MortonBits)
+		{
+			int32& Coordinate = Cell[MortonBit >> 5];
+			const int32 Mask = 1 << (MortonBit & 31);
+			if (Coordinate & Mask)
+			{
+				Coordinate &= ~Mask;
+			}
+			else {
+				Coordinate |= Mask;
+				bCarry = false;
+				break;
+			}
+		}
+		if (bCarry)
+		{
+			bDone = true;
+			return;
+		}
+	} while (!IsInside());
+}
+
+void FMultiFrameGridWalker::NextHilbert()
+{
+	const int64 BlockCells = (int64)HilbertSide * HilbertSide;
+	do
+	{
+		if (++HilbertIndex >= BlockCells)
+		{
+			HilbertIndex = 0;
+			HilbertOrigin.X += HilbertSide;
+			if (HilbertOrigin.X >= Size.X)
+			{
+				HilbertOrigin.X = 0;
+				HilbertOrigin.Y += HilbertSide;
+				if (HilbertOrigin.Y >= Size.Y)
+				{
+					HilbertOrigin.Y = 0;
+					if (++HilbertOrigin.Z >= Size.Z)
+					{
+						bDone = true;
+						return;
+					}
+				}
+			}
+		}
+		DecodeHilbert();
+	} while (!IsInside());
+}
+
+void FMultiFrameGridWalker::DecodeHilbert()
+{
+	int32 X = 0;
+	int32 Y = 0;
+	int64 Remaining = HilbertIndex;
+	for (int32 Side = 1; Side < HilbertSide; Side *= 2)
+	{
+		const int32 RX = (int32)(1 & (Remaining / 2));
+		const int32 RY = (int32)(1 & (Remaining ^ RX));
+		if (RY == 0)
+		{
+			if (RX == 1)
+			{
+				X = Side - 1 - X;
+				Y = Side - 1 - Y;
+			}
+			Swap(X, Y);
+		}
+		X += Side * RX;
+		Y += Side * RY;
+		Remaining /= 4;
+	}
+	Cell = FIntVector(HilbertOrigin.X + X, HilbertOrigin.Y + Y, HilbertOrigin.Z);
+}
@@ -3,7 +3,6 @@
 
 UMultiFrameLoop1DTask::UMultiFrameLoop1DTask()
 {
-	bIsTickable = true;
 }
 
 UMultiFrameLoop1DTask::~UMultiFrameLoop1DTask()
@@ -12,10 +11,12 @@ UMultiFrameLoop1DTask::~UMultiFrameLoop1DTask()
 
 bool UMultiFrameLoop1DTask::Start()
 {
-	if (XSize > 0 && IterationsPerTick >= 1 && Delay >= 0.0f)
+	if (XSize > 0 && IterationsPerTick >= 1 && Delay >= 0.0f && TimeBudget >= 0.0f)
 	{
 		TimeRemaining = 0.0f;
 		bStarted = true;
+		EnterGroup();
+		Schedule();
 		return true;
 	}
 	return false;
@@ -34,30 +35,18 @@ bool UMultiFrameLoop1DTask::IsRunning()
 	return false;
 }
 
-void UMultiFrameLoop1DTask::Tick(float DeltaTime)
+bool UMultiFrameLoop1DTask::HasPendingIterations() const
 {
-	if (bStarted && !IsCanceled())
+	return CurrentIndex < XSize;
+}
+
+void UMultiFrameLoop1DTask::ExecuteIteration()
+{
+	const int32 CurrentX = CurrentIndex % XSize;
+	TaskBody(CurrentX);
+	if (TaskDelegate.IsBound())
 	{
-		TimeRemaining -= DeltaTime;
-		if (TimeRemaining <= 0.0f)
-		{
-			TimeRemaining = Delay;
-			for (int32 CurrentIt = 0; CurrentIndex < XSize && CurrentIt < IterationsPerTick; CurrentIt++, CurrentIndex++)
-			{
-				if (IsCanceled())
-				{
-					break;
-				}
-				else {
-					const int32 CurrentX = CurrentIndex % XSize;
-					TaskBody(CurrentX);
-					if (TaskDelegate.IsBound())
-					{
-						TaskDelegate.Broadcast();
-					}
-				}
-			}
-		}
+		TaskDelegate.Broadcast();
 	}
-	//UMultiTaskBase::Tick(DeltaTime);
+	CurrentIndex++;
 }
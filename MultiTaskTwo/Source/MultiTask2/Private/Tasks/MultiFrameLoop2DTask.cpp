@@ -3,7 +3,6 @@
 
 UMultiFrameLoop2DTask::UMultiFrameLoop2DTask()
 {
-	bIsTickable = true;
 }
 
 UMultiFrameLoop2DTask::~UMultiFrameLoop2DTask()
@@ -12,10 +11,13 @@ UMultiFrameLoop2DTask::~UMultiFrameLoop2DTask()
 
 bool UMultiFrameLoop2DTask::Start()
 {
-	if ((XSize * YSize) > 0 && IterationsPerTick >= 1 && Delay >= 0.0f)
+	if ((XSize * YSize) > 0 && IterationsPerTick >= 1 && Delay >= 0.0f && TimeBudget >= 0.0f && TileSize >= 1)
 	{
 		TimeRemaining = 0.0f;
+		Walker.Reset(IterationOrder, FIntVector(XSize, YSize, 1), TileSize);
 		bStarted = true;
+		EnterGroup();
+		Schedule();
 		return true;
 	}
 	return false;
@@ -35,32 +37,19 @@ bool UMultiFrameLoop2DTask::IsRunning()
 	return false;
 }
 
-void UMultiFrameLoop2DTask::Tick(float DeltaTime)
+bool UMultiFrameLoop2DTask::HasPendingIterations() const
 {
-	if (bStarted && !IsCanceled())
+	return CurrentIndex < XSize * YSize;
+}
+
+void UMultiFrameLoop2DTask::ExecuteIteration()
+{
+	const FIntVector& Cell = Walker.GetCell();
+	TaskBody(Cell.X, Cell.Y);
+	if (TaskDelegate.IsBound())
 	{
-		TimeRemaining -= DeltaTime;
-		if (TimeRemaining <= 0.0f)
-		{
-			TimeRemaining = Delay;
-			const int32 Size = XSize * YSize;
-			for (int32 CurrentIt = 0; CurrentIndex < Size && CurrentIt < IterationsPerTick; CurrentIt++, CurrentIndex++)
-			{
-				if (IsCanceled())
-				{
-					break;
-				}
-				else {
-					const int32 CurrentX = CurrentIndex % XSize;
-					const int32 CurrentY = (CurrentIndex / XSize) % YSize;
-					TaskBody(CurrentX, CurrentY);
-					if (TaskDelegate.IsBound())
-					{
-						TaskDelegate.Broadcast();
-					}
-				}
-			}
-		}
+		TaskDelegate.Broadcast();
 	}
-	//UMultiTaskBase::Tick(DeltaTime);
+	Walker.Next();
+	CurrentIndex++;
 }
@@ -3,7 +3,6 @@
 
 UMultiFrameLoop3DTask::UMultiFrameLoop3DTask()
 {
-	bIsTickable = true;
 }
 
 UMultiFrameLoop3DTask::~UMultiFrameLoop3DTask()
@@ -12,10 +11,13 @@ UMultiFrameLoop3DTask::~UMultiFrameLoop3DTask()
 
 bool UMultiFrameLoop3DTask::Start()
 {
-	if ((XSize * YSize * ZSize) > 0 && IterationsPerTick >= 1 && Delay >= 0.0f)
+	if ((XSize * YSize * ZSize) > 0 && IterationsPerTick >= 1 && Delay >= 0.0f && TimeBudget >= 0.0f && TileSize >= 1)
 	{
 		TimeRemaining = 0.0f;
+		Walker.Reset(IterationOrder, FIntVector(XSize, YSize, ZSize), TileSize);
 		bStarted = true;
+		EnterGroup();
+		Schedule();
 		return true;
 	}
 	return false;
@@ -35,34 +37,19 @@ bool UMultiFrameLoop3DTask::IsRunning()
 	return false;
 }
 
-void UMultiFrameLoop3DTask::Tick(float DeltaTime)
+bool UMultiFrameLoop3DTask::HasPendingIterations() const
 {
-	if (bStarted && !IsCanceled())
+	return CurrentIndex < XSize * YSize * ZSize;
+}
+
+void UMultiFrameLoop3DTask::ExecuteIteration()
+{
+	const FIntVector& Cell = Walker.GetCell();
+	TaskBody(Cell.X, Cell.Y, Cell.Z);
+	if (TaskDelegate.IsBound())
 	{
-		TimeRemaining -= DeltaTime;
-		if (TimeRemaining <= 0.0f)
-		{
-			TimeRemaining = Delay;
-			const int32 Size = XSize * YSize * ZSize;
-			for (int32 CurrentIt = 0; CurrentIndex < Size && CurrentIt < IterationsPerTick; CurrentIt++, CurrentIndex++)
-			{
-				if (IsCanceled())
-				{
-					break;
-				}
-				else {
-					const int32 CurrentX = CurrentIndex % XSize;
-					const int32 CurrentY = (CurrentIndex / XSize) % YSize;
-					const int32 CurrentZ = CurrentIndex / (XSize * YSize);
-					TaskBody(CurrentX, CurrentY, CurrentZ);
-					if (TaskDelegate.IsBound())
-					{
-						TaskDelegate.Broadcast();
-					}
-				}
-			}
-		}
+		TaskDelegate.Broadcast();
 	}
-	//OnTick(DeltaTime);
-	//UMultiTaskBase::Tick(DeltaTime);
+	Walker.Next();
+	CurrentIndex++;
 }
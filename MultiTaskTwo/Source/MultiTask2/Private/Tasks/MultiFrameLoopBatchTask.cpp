@@ -0,0 +1,64 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiFrameLoopBatchTask.h"
+
+UMultiFrameLoopBatchTask::UMultiFrameLoopBatchTask()
+{
+}
+
+UMultiFrameLoopBatchTask::~UMultiFrameLoopBatchTask()
+{
+}
+
+bool UMultiFrameLoopBatchTask::Start()
+{
+	if (XSize > 0 && YSize > 0 && ZSize > 0 && BatchSize >= 1 && IterationsPerTick >= 1 && Delay >= 0.0f && TimeBudget >= 0.0f)
+	{
+		TimeRemaining = 0.0f;
+		bStarted = true;
+		EnterGroup();
+		Schedule();
+		return true;
+	}
+	return false;
+}
+
+void UMultiFrameLoopBatchTask::TaskBody_Implementation(int32 FirstX, int32 LastX, int32 Y, int32 Z)
+{
+}
+
+bool UMultiFrameLoopBatchTask::IsRunning()
+{
+	if (!IsCanceled() && bStarted)
+	{
+		return CurrentZ < ZSize;
+	}
+	return false;
+}
+
+bool UMultiFrameLoopBatchTask::HasPendingIterations() const
+{
+	return CurrentZ < ZSize;
+}
+
+void UMultiFrameLoopBatchTask::ExecuteIteration()
+{
+	const int32 FirstX = CurrentX;
+	const int32 LastX = FMath::Min(XSize - FirstX, BatchSize) + FirstX - 1;
+	TaskBody(FirstX, LastX, CurrentY, CurrentZ);
+	if (TaskDelegate.IsBound())
+	{
+		TaskDelegate.Broadcast(FirstX, LastX, CurrentY, CurrentZ);
+	}
+
+	// Advance without rebuilding the coordinates from a linear index.
+	CurrentX = LastX + 1;
+	if (CurrentX >= XSize)
+	{
+		CurrentX = 0;
+		if (++CurrentY >= YSize)
+		{
+			CurrentY = 0;
+			CurrentZ++;
+		}
+	}
+}
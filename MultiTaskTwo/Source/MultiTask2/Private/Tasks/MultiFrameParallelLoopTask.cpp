@@ -0,0 +1,216 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiFrameParallelLoopTask.h"
+#include "MultiTaskThreadPool.h"
+#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/PlatformProcess.h"
+
+/**
+* One slice of the index space. Workers claim chunks of it until none are left, Game Thread polls it without waiting.
+*/
+struct FMultiFrameParallelSlice
+{
+	FMultiFrameParallelSlice(int32 InFirst, int32 InCount, int32 InChunkSize, int32 InNumWorkers, TFunction<void(int32)>&& InBody)
+		: First(InFirst)
+		, Count(InCount)
+		, ChunkSize(InChunkSize)
+		, Body(MoveTemp(InBody))
+		, PendingWorkers(InNumWorkers)
+	{}
+
+	void Work()
+	{
+		Running.Increment();
+		if (!bStopped)
+		{
+			int32 ChunkStart = (NextChunk.Increment() - 1) * ChunkSize;
+			while (ChunkStart < Count)
+			{
+				const int32 ChunkEnd = FMath::Min(ChunkStart + ChunkSize, Count);
+				for (int32 Index = ChunkStart; Index < ChunkEnd && !bStopped; ++Index)
+				{
+					Body(First + Index);
+				}
+				Finished.Add(ChunkEnd - ChunkStart);
+				ChunkStart = (NextChunk.Increment() - 1) * ChunkSize;
+			}
+		}
+		Running.Decrement();
+		PendingWorkers.Decrement();
+	}
+
+	/**
+	* Called instead of Work when the pool dropped a worker job. If it was the last one, nobody is left to run the unclaimed chunks.
+	*/
+	void Discard()
+	{
+		if (PendingWorkers.Decrement() == 0 && !IsDone())
+		{
+			bAbandoned = true;
+			int32 ChunkStart = (NextChunk.Increment() - 1) * ChunkSize;
+			while (ChunkStart < Count)
+			{
+				Finished.Add(FMath::Min(ChunkStart + ChunkSize, Count) - ChunkStart);
+				ChunkStart = (NextChunk.Increment() - 1) * ChunkSize;
+			}
+		}
+	}
+
+	/**
+	* Keep workers from calling Body again and wait for the ones inside it. Jobs starting later return right away.
+	*/
+	void Stop()
+	{
+		bStopped = true;
+		while (Running.GetValue() > 0)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+	}
+
+	bool IsDone() const
+	{
+		return Finished.GetValue() >= Count;
+	}
+
+	const int32 First;
+	const int32 Count;
+	const int32 ChunkSize;
+	TFunction<void(int32)> Body;
+	FThreadSafeCounter NextChunk;
+	FThreadSafeCounter Finished;
+	FThreadSafeCounter PendingWorkers;
+	FThreadSafeCounter Running;
+	FThreadSafeBool bStopped = false;
+	FThreadSafeBool bAbandoned = false;
+};
+
+UMultiFrameParallelLoopTask::UMultiFrameParallelLoopTask()
+{
+}
+
+UMultiFrameParallelLoopTask::~UMultiFrameParallelLoopTask()
+{
+	if (Slice.IsValid())
+	{
+		Slice->Stop();
+	}
+}
+
+void UMultiFrameParallelLoopTask::BeginDestroy()
+{
+	// Workers still queued keep the slice alive but must not reach the Task. Only the bodies already executing are waited for.
+	if (Slice.IsValid())
+	{
+		Slice->Stop();
+	}
+	Super::BeginDestroy();
+}
+
+bool UMultiFrameParallelLoopTask::Start()
+{
+	if (XSize > 0 && YSize > 0 && ZSize > 0 && SliceSize >= 1 && Delay >= 0.0f)
+	{
+		TimeRemaining = 0.0f;
+		bStarted = true;
+		EnterGroup();
+		Schedule();
+		return true;
+	}
+	return false;
+}
+
+void UMultiFrameParallelLoopTask::TaskBody_Implementation(int32 X, int32 Y, int32 Z)
+{
+}
+
+bool UMultiFrameParallelLoopTask::IsRunning()
+{
+	if (!bStarted)
+	{
+		return false;
+	}
+	if (IsSliceInFlight())
+	{
+		return true;
+	}
+	return !IsCanceled() && (CurrentIndex < XSize * YSize * ZSize || Slice.IsValid());
+}
+
+bool UMultiFrameParallelLoopTask::IsSliceInFlight() const
+{
+	return Slice.IsValid() && !Slice->IsDone();
+}
+
+bool UMultiFrameParallelLoopTask::HasPendingIterations() const
+{
+	if (Slice.IsValid())
+	{
+		return Slice->IsDone();
+	}
+	return CurrentIndex < XSize * YSize * ZSize;
+}
+
+void UMultiFrameParallelLoopTask::ExecuteIteration()
+{
+	// Sync point: the previous slice is complete, report it before starting the next one.
+	if (Slice.IsValid())
+	{
+		const int32 FirstIndex = Slice->First;
+		const int32 LastIndex = Slice->First + Slice->Count - 1;
+		const bool bAbandoned = Slice->bAbandoned;
+		Slice.Reset();
+		if (bAbandoned)
+		{
+			// The pool dropped the work, the same as for Thread Tasks this ends the loop on the canceled branch.
+			MarkCanceled();
+			return;
+		}
+		if (TaskDelegate.IsBound())
+		{
+			TaskDelegate.Broadcast(FirstIndex, LastIndex);
+		}
+	}
+
+	const int32 Size = XSize * YSize * ZSize;
+	if (CurrentIndex < Size && !IsCanceled())
+	{
+		const int32 Count = FMath::Min(SliceSize, Size - CurrentIndex);
+		LaunchSlice(CurrentIndex, Count);
+		CurrentIndex += Count;
+	}
+}
+
+void UMultiFrameParallelLoopTask::LaunchSlice(int32 First, int32 Count)
+{
+	UMultiFrameParallelLoopTask* Worker = this;
+	const int32 LocalXSize = XSize;
+	const int32 LocalXYSize = XSize * YSize;
+
+	const bool bUsePool = ThreadPool && ThreadPool->GetThreadsNum() > 0;
+	const int32 MaxWorkers = bUsePool ? ThreadPool->GetThreadsNum() : FTaskGraphInterface::Get().GetNumWorkerThreads();
+	const int32 NumWorkers = FMath::Clamp(MaxWorkers, 1, Count);
+	// A few chunks per worker balance uneven bodies without contending on every index.
+	const int32 ChunkSize = FMath::Max(Count / (NumWorkers * 4), 1);
+
+	Slice = MakeShared<FMultiFrameParallelSlice, ESPMode::ThreadSafe>(First, Count, ChunkSize, NumWorkers, [Worker, LocalXSize, LocalXYSize](int32 Index)
+	{
+		if (IsValid(Worker) && !Worker->HasAnyFlags(RF_BeginDestroyed) && !Worker->IsUnreachable() && !Worker->IsCanceled())
+		{
+			Worker->TaskBody(Index % LocalXSize, (Index % LocalXYSize) / LocalXSize, Index / LocalXYSize);
+		}
+	});
+
+	TSharedRef<FMultiFrameParallelSlice, ESPMode::ThreadSafe> LocalSlice = Slice.ToSharedRef();
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		if (bUsePool)
+		{
+			ThreadPool->Launch([LocalSlice]() { LocalSlice->Work(); }, nullptr, Priority, -1.0, NAME_None, nullptr, [LocalSlice]() { LocalSlice->Discard(); });
+		}
+		else {
+			Async(EAsyncExecution::TaskGraph, [LocalSlice]() { LocalSlice->Work(); });
+		}
+	}
+}
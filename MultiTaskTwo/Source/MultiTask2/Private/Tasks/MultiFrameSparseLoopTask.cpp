@@ -0,0 +1,81 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiFrameSparseLoopTask.h"
+
+UMultiFrameSparseLoopTask::UMultiFrameSparseLoopTask()
+{
+}
+
+UMultiFrameSparseLoopTask::~UMultiFrameSparseLoopTask()
+{
+}
+
+bool UMultiFrameSparseLoopTask::Start()
+{
+	if (XSize > 0 && YSize > 0 && IterationsPerTick >= 1 && Delay >= 0.0f && TimeBudget >= 0.0f)
+	{
+		TimeRemaining = 0.0f;
+		IndicesPosition = 0;
+		MaskWord = 0;
+		MaskBits = Mask.Num() > 0 ? (uint64)Mask[0] : 0;
+		SkipIndicesAndEmptyWords();
+		bStarted = true;
+		EnterGroup();
+		Schedule();
+		return true;
+	}
+	return false;
+}
+
+void UMultiFrameSparseLoopTask::TaskBody_Implementation(int32 Index, int32 X, int32 Y, int32 Z)
+{
+}
+
+bool UMultiFrameSparseLoopTask::IsRunning()
+{
+	if (!IsCanceled() && bStarted)
+	{
+		return HasPendingIterations();
+	}
+	return false;
+}
+
+bool UMultiFrameSparseLoopTask::HasPendingIterations() const
+{
+	return IndicesPosition < Indices.Num() || MaskBits != 0;
+}
+
+void UMultiFrameSparseLoopTask::SkipIndicesAndEmptyWords()
+{
+	while (IndicesPosition < Indices.Num() && Indices[IndicesPosition] < 0)
+	{
+		IndicesPosition++;
+	}
+	while (MaskBits == 0 && MaskWord + 1 < Mask.Num())
+	{
+		MaskBits = (uint64)Mask[++MaskWord];
+	}
+}
+
+void UMultiFrameSparseLoopTask::ExecuteIteration()
+{
+	int32 Index = 0;
+	if (IndicesPosition < Indices.Num())
+	{
+		Index = Indices[IndicesPosition++];
+	}
+	else {
+		Index = MaskWord * 64 + (int32)FMath::CountTrailingZeros64(MaskBits);
+		// Clear the lowest set bit.
+		MaskBits &= MaskBits - 1;
+	}
+	SkipIndicesAndEmptyWords();
+
+	const int32 X = Index % XSize;
+	const int32 Y = (Index / XSize) % YSize;
+	const int32 Z = Index / (XSize * YSize);
+	TaskBody(Index, X, Y, Z);
+	if (TaskDelegate.IsBound())
+	{
+		TaskDelegate.Broadcast(Index, X, Y, Z);
+	}
+}
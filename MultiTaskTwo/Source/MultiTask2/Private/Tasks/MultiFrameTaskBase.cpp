@@ -0,0 +1,70 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#include "MultiFrameTaskBase.h"
+#include "MultiTask2.h"
+#include "MultiFrameTaskScheduler.h"
+
+UMultiFrameTaskBase::UMultiFrameTaskBase()
+{
+}
+
+bool UMultiFrameTaskBase::HasPendingIterations() const
+{
+	return false;
+}
+
+void UMultiFrameTaskBase::ExecuteIteration()
+{
+}
+
+ETickableTickType UMultiFrameTaskBase::GetTickableTickType() const
+{
+	return ETickableTickType::Never;
+}
+
+void UMultiFrameTaskBase::Schedule()
+{
+	if (UMultiFrameTaskScheduler* Scheduler = FMultiTask2Module::Get().GetMultiFrameScheduler())
+	{
+		Scheduler->Register(this);
+	}
+}
+
+bool UMultiFrameTaskBase::AdvanceDelay(float DeltaTime)
+{
+	if (!bStarted || IsCanceled())
+	{
+		return false;
+	}
+	if (TimeRemaining > 0.0f)
+	{
+		TimeRemaining -= DeltaTime;
+	}
+	return TimeRemaining <= 0.0f;
+}
+
+void UMultiFrameTaskBase::RunIterations(double FrameEndTime)
+{
+	TimeRemaining = Delay;
+
+	double EndTime = FrameEndTime;
+	if (TimeBudget > 0.0f)
+	{
+		const double TaskEndTime = FPlatformTime::Seconds() + (double)TimeBudget / 1000.0;
+		EndTime = EndTime > 0.0 ? FMath::Min(EndTime, TaskEndTime) : TaskEndTime;
+	}
+
+	const int32 MaxIterations = TimeBudget > 0.0f ? MAX_int32 : IterationsPerTick;
+	const int32 CheckInterval = FMath::Max(TimeCheckInterval, 1);
+	for (int32 CurrentIt = 0; CurrentIt < MaxIterations && HasPendingIterations(); CurrentIt++)
+	{
+		if (IsCanceled())
+		{
+			break;
+		}
+		ExecuteIteration();
+		if (EndTime > 0.0 && (CurrentIt + 1) % CheckInterval == 0 && FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+}
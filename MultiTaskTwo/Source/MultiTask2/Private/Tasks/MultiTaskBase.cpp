@@ -1,6 +1,11 @@
 // Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
 #include "MultiTaskBase.h"
+#include "MultiTaskGroup.h"
 #include "Async/Async.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
 #ifndef ENGINE_MINOR_VERSION
 #include "Runtime/Launch/Resources/Version.h"
 #endif
@@ -13,9 +18,21 @@ UMultiTaskBase::UMultiTaskBase()
 
 UMultiTaskBase::~UMultiTaskBase()
 {
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
     UMultiTask2UtilitiesLibrary::RemoveFromRoot(this);
 }
 
+void UMultiTaskBase::BeginDestroy()
+{
+    // A Task collected before it stopped running must not keep its Group waiting.
+    if (IsValid(RunningGroup) && !RunningGroup->HasAnyFlags(RF_BeginDestroyed) && !RunningGroup->IsUnreachable())
+    {
+        LeaveGroup();
+    }
+    RunningGroup = nullptr;
+    Super::BeginDestroy();
+}
+
 bool UMultiTaskBase::Start()
 {
     
@@ -27,27 +44,91 @@ void UMultiTaskBase::Cancel()
 {
     if (IsRunning() && !IsCanceled())
     {
-        bCanceled = true;
+        MarkCanceled();
+    }
+}
 
-        UMultiTaskBase* Worker = this;
+void UMultiTaskBase::MarkCanceled()
+{
+    bCanceled = true;
+
+    UMultiTaskBase* Worker = this;
 
-        AsyncTask(ENamedThreads::GameThread, [Worker]()
+    AsyncTask(ENamedThreads::GameThread, [Worker]()
+    {
+        if (IsValid(Worker) && !Worker->HasAnyFlags(RF_BeginDestroyed) && !Worker->IsUnreachable())
         {
-            if (IsValid(Worker) && !Worker->HasAnyFlags(RF_BeginDestroyed) && !Worker->IsUnreachable())
+            if (UFunction* Function = Worker->FindFunction(FName("OnCancel")))
             {
-                if (UFunction* Function = Worker->FindFunction(FName("OnCancel")))
+                if(IsValid(Function) && !Function->HasAnyFlags(RF_BeginDestroyed) && !Function->IsUnreachable())
                 {
-                    if(IsValid(Function) && !Function->HasAnyFlags(RF_BeginDestroyed) && !Function->IsUnreachable())
-                    {
-                        Worker->OnCancel();
-                    }
-                }
-                if (Worker->OnCancelDelegate.IsBound())
-                {
-                    Worker->OnCancelDelegate.Broadcast();
+                    Worker->OnCancel();
                 }
             }
-        });
+            if (Worker->OnCancelDelegate.IsBound())
+            {
+                Worker->OnCancelDelegate.Broadcast();
+            }
+        }
+    });
+}
+
+void UMultiTaskBase::BindToLifetime(UObject* Owner)
+{
+    if (!(IsValid(Owner) && !Owner->HasAnyFlags(RF_BeginDestroyed) && !Owner->IsUnreachable()))
+    {
+        return;
+    }
+
+    if (UActorComponent* Component = Cast<UActorComponent>(Owner))
+    {
+        Owner = Component->GetOwner();
+    }
+
+    if (AActor* Actor = Cast<AActor>(Owner))
+    {
+        Actor->OnEndPlay.AddUniqueDynamic(this, &UMultiTaskBase::OnLifetimeActorEndPlay);
+        return;
+    }
+
+    ULevel* Level = Cast<ULevel>(Owner);
+    if (!Level && Owner)
+    {
+        Level = Owner->GetTypedOuter<ULevel>();
+    }
+    if (Level)
+    {
+        LifetimeLevel = Level;
+        if (!LevelRemovedHandle.IsValid())
+        {
+            LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UMultiTaskBase::OnLifetimeLevelRemoved);
+        }
+    }
+}
+
+void UMultiTaskBase::OnLifetimeEnded()
+{
+    Cancel();
+}
+
+void UMultiTaskBase::OnLifetimeActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+    if (IsValid(Actor))
+    {
+        Actor->OnEndPlay.RemoveDynamic(this, &UMultiTaskBase::OnLifetimeActorEndPlay);
+    }
+    OnLifetimeEnded();
+}
+
+void UMultiTaskBase::OnLifetimeLevelRemoved(ULevel* Level, UWorld* World)
+{
+    // A null level means every level of the world got removed.
+    if (Level == nullptr || Level == LifetimeLevel.Get())
+    {
+        FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+        LevelRemovedHandle.Reset();
+        LifetimeLevel.Reset();
+        OnLifetimeEnded();
     }
 }
 
@@ -59,7 +140,26 @@ bool UMultiTaskBase::IsRunning()
 
 bool UMultiTaskBase::IsCanceled()
 {
-    return bCanceled;
+    return bCanceled || (Group && Group->IsCanceled());
+}
+
+void UMultiTaskBase::EnterGroup()
+{
+    LeaveGroup();
+    if (IsValid(Group) && !Group->HasAnyFlags(RF_BeginDestroyed) && !Group->IsUnreachable())
+    {
+        RunningGroup = Group;
+        RunningGroup->OnWorkStarted();
+    }
+}
+
+void UMultiTaskBase::LeaveGroup()
+{
+    if (RunningGroup)
+    {
+        RunningGroup->OnWorkFinished();
+        RunningGroup = nullptr;
+    }
 }
 
 void UMultiTaskBase::OnCancel_Implementation()
@@ -11,20 +11,6 @@ bool UMultiThreadTask::Start()
 
     bCanceled = false;
 
-    EAsyncExecution AsyncType = EAsyncExecution::ThreadPool;
-    switch (ExecutionType)
-    {
-    case ETaskExecutionType::TaskGraph:
-        AsyncType = EAsyncExecution::TaskGraph;
-        break;
-    case ETaskExecutionType::Thread:
-        AsyncType = EAsyncExecution::Thread;
-        break;
-    case ETaskExecutionType::ThreadPool:
-        AsyncType = EAsyncExecution::ThreadPool;
-        break;
-    }
-
     UMultiThreadTask* Worker = this;
 
     TFunction<void()> BodyFunc = [Worker]()
@@ -53,13 +39,7 @@ bool UMultiThreadTask::Start()
         });
     };
     Tasks.SetNumZeroed(1);
-    if (AsyncType == EAsyncExecution::ThreadPool && ThreadPool && ThreadPool->GetThreadsNum() > 0)
-    {
-        Tasks[0] = AsyncPool(ThreadPool->Obj.ToSharedRef().Get(), TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
-    }
-    else {
-        Tasks[0] = Async(AsyncType, TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
-    }
+    Tasks[0] = LaunchWork(TUniqueFunction<void()>(BodyFunc), TUniqueFunction<void()>(OnCompleteFunc));
 
 
     return true;
@@ -68,3 +48,18 @@ bool UMultiThreadTask::Start()
 void UMultiThreadTask::TaskBody_Implementation()
 {
 }
+
+void UMultiThreadTask::ForkJoinChildren(int32 Count)
+{
+    ForkJoin(Count, [this](int32 Index)
+    {
+        if (!IsCanceled())
+        {
+            ChildBody(Index);
+        }
+    });
+}
+
+void UMultiThreadTask::ChildBody_Implementation(int32 Index)
+{
+}
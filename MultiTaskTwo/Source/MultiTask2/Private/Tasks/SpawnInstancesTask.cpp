@@ -34,20 +34,6 @@ bool USpawnInstancesTask::Start()
 
     bCanceled = false;
 
-    EAsyncExecution AsyncType = EAsyncExecution::ThreadPool;
-    switch (ExecutionType)
-    {
-    case ETaskExecutionType::TaskGraph:
-        AsyncType = EAsyncExecution::TaskGraph;
-        break;
-    case ETaskExecutionType::Thread:
-        AsyncType = EAsyncExecution::Thread;
-        break;
-    case ETaskExecutionType::ThreadPool:
-        AsyncType = EAsyncExecution::ThreadPool;
-        break;
-    }
-
     PerInstanceSMData.SetNumZeroed(TransformArraySize);
     InstanceBodies.SetNumZeroed(TransformArraySize);
     InstanceReorderTable.SetNumZeroed(TransformArraySize);
@@ -55,6 +41,7 @@ bool USpawnInstancesTask::Start()
     Cmds.SetNumZeroed(TransformArraySize);
     NewInstances->SetNumZeroed(TransformArraySize);
     UnbuiltInstanceBounds.Init();
+    SpawnedInstancesNum = 0;
 
     HISMTransform = HISM->GetComponentTransform();
     MeshBounds = HISM->GetStaticMesh()->GetBounds().GetBox();
@@ -66,6 +53,7 @@ bool USpawnInstancesTask::Start()
     const int32 Chunks = LastChunkSize > 0 ? TaskCount + 1 : TaskCount;
 
     Tasks.SetNumZeroed(Chunks);
+    ChunkResults.SetNum(Chunks);
 
     for (int32 ChunkIndex = 0; ChunkIndex < Chunks; ++ChunkIndex)
     {
@@ -80,13 +68,7 @@ bool USpawnInstancesTask::Start()
             Worker->TaskBody(IterationSize, ChunkIndex, ChunkSize);
         };
 
-        if (AsyncType == EAsyncExecution::ThreadPool && ThreadPool && ThreadPool->GetThreadsNum() > 0)
-        {
-            Tasks[ChunkIndex] = AsyncPool(ThreadPool->Obj.ToSharedRef().Get(), TUniqueFunction<void()>(BodyFunc));
-        }
-        else {
-            Tasks[ChunkIndex] = Async(AsyncType, TUniqueFunction<void()>(BodyFunc));
-        }
+        Tasks[ChunkIndex] = LaunchWork(TUniqueFunction<void()>(BodyFunc), nullptr, IterationSize);
 
     }
 
@@ -100,11 +82,15 @@ void USpawnInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32
         const int32 BaseIndex = HISM->PerInstanceSMData.Num();
         const int32 InitialBufferOffset = HISM->InstanceCountToRender - HISM->InstanceReorderTable.Num();
 
+        // Accumulate locally and publish once, workers never write to shared state other than their own slice.
+        FBox ChunkBounds(ForceInit);
+        int32 ChunkInstancesNum = 0;
+
         for (int32 X = 0; X < IterationSize; ++X)
         {
             if (!(IsValid(HISM) && !HISM->HasAnyFlags(RF_BeginDestroyed) && !HISM->IsUnreachable() && !IsCanceled()))
             {
-                return;
+                break;
             }
 
             const int32 Index = (ChunkIndex * ChunkSize) + X;
@@ -115,7 +101,7 @@ void USpawnInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32
             PerInstanceSMData[Index].Transform = NewMatrix;
 
             const FBox NewInstanceBounds = MeshBounds.TransformBy(NewLocalTransform);
-            UnbuiltInstanceBounds += NewInstanceBounds;
+            ChunkBounds += NewInstanceBounds;
             InstanceReorderTable[Index] = InitialBufferOffset + Index;
 
             UnbuiltInstanceBoundsList[Index] = NewInstanceBounds;
@@ -126,8 +112,27 @@ void USpawnInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32
             Cmd.XForm = NewMatrix;
 
             NewInstances->GetData()[Index] = Index;
+            ChunkInstancesNum++;
         }
+
+        ChunkResults[ChunkIndex].Bounds = ChunkBounds;
+        ChunkResults[ChunkIndex].InstancesNum = ChunkInstancesNum;
+    }
+}
+
+bool USpawnInstancesTask::MergeChunkResults()
+{
+    check(IsInGameThread());
+    // Merged in chunk order so the result does not depend on which worker finished first.
+    UnbuiltInstanceBounds.Init();
+    SpawnedInstancesNum = 0;
+    for (const FSpawnInstancesChunkResult& ChunkResult : ChunkResults)
+    {
+        UnbuiltInstanceBounds += ChunkResult.Bounds;
+        SpawnedInstancesNum += ChunkResult.InstancesNum;
     }
+    ChunkResults.Empty();
+    return SpawnedInstancesNum == TransformArraySize;
 }
 
 void USpawnInstancesTask::CreatePhysicsBodies()
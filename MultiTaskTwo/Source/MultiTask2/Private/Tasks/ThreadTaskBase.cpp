@@ -1,5 +1,12 @@
 // Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
 #include "ThreadTaskBase.h"
+#include "MultiTaskGroup.h"
+#include "MultiTaskCostModel.h"
+#include "MultiTaskPipe.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Tasks/Task.h"
 #ifndef ENGINE_MINOR_VERSION
 #include "Runtime/Launch/Resources/Version.h"
 #endif
@@ -53,6 +60,281 @@ void UThreadTaskBase::WaitToFinish()
     while (IsRunning());
 }
 
+bool UThreadTaskBase::ShouldYield()
+{
+    if (ExecutionType == ETaskExecutionType::ThreadPool && ThreadPool)
+    {
+        return ThreadPool->HasWaitingWork(Priority);
+    }
+    return false;
+}
+
+bool UThreadTaskBase::YieldToPendingWork()
+{
+    if (ShouldYield() && !IsInGameThread())
+    {
+        return ThreadPool->RunWaitingWork(Priority);
+    }
+    return false;
+}
+
+namespace MultiTaskForkJoin
+{
+    struct FState
+    {
+        FState(int32 InCount, TFunctionRef<void(int32)> InChildBody)
+            : Count(InCount)
+            , ChildBody(InChildBody)
+            , JoinEvent(FPlatformProcess::GetSynchEventFromPool(true))
+        {}
+
+        ~FState()
+        {
+            FPlatformProcess::ReturnSynchEventToPool(JoinEvent);
+        }
+
+        // Claims child indices until all of them are taken. ChildBody is only touched for a claimed index,
+        // the joining thread can't return before that child finished so the reference is still alive.
+        void Work()
+        {
+            int32 Index = NextIndex.Increment() - 1;
+            while (Index < Count)
+            {
+                ChildBody(Index);
+                if (Finished.Increment() == Count)
+                {
+                    JoinEvent->Trigger();
+                }
+                Index = NextIndex.Increment() - 1;
+            }
+        }
+
+        const int32 Count;
+        TFunctionRef<void(int32)> ChildBody;
+        FEvent* JoinEvent;
+        FThreadSafeCounter NextIndex;
+        FThreadSafeCounter Finished;
+    };
+}
+
+void UThreadTaskBase::ForkJoin(int32 Count, TFunctionRef<void(int32)> ChildBody)
+{
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    TSharedRef<MultiTaskForkJoin::FState, ESPMode::ThreadSafe> State = MakeShared<MultiTaskForkJoin::FState, ESPMode::ThreadSafe>(Count, ChildBody);
+
+    const bool bUsePool = ThreadPool && ThreadPool->GetThreadsNum() > 0;
+    const int32 MaxHelpers = bUsePool ? ThreadPool->GetThreadsNum() : FTaskGraphInterface::Get().GetNumWorkerThreads();
+    const int32 NumHelpers = FMath::Min(Count - 1, MaxHelpers);
+    for (int32 HelperIndex = 0; HelperIndex < NumHelpers; ++HelperIndex)
+    {
+        if (bUsePool)
+        {
+            // Never waits for room, the joining worker runs the children of helpers rejected by a full queue.
+            ThreadPool->TryLaunch([State]() { State->Work(); }, Priority);
+        }
+        else {
+            Async(EAsyncExecution::TaskGraph, [State]() { State->Work(); });
+        }
+    }
+
+    // Help while waiting: the joining worker runs children until none are left to claim, then parks until the last one finished.
+    State->Work();
+    while (State->Finished.GetValue() < Count)
+    {
+        State->JoinEvent->Wait();
+    }
+}
+
+int32 UThreadTaskBase::GetWorkSize() const
+{
+    return WorkSize;
+}
+
+float UThreadTaskBase::GetExpectedCost()
+{
+    return (float)FMultiTaskCostModel::Get().Estimate(GetClass()->GetFName(), GetWorkSize());
+}
+
+TFuture<void> UThreadTaskBase::LaunchWork(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, int32 InWorkSize)
+{
+    const FName CostClass = GetClass()->GetFName();
+    const int32 CostSize = InWorkSize == INDEX_NONE ? GetWorkSize() : InWorkSize;
+    const double ExpectedCost = FMultiTaskCostModel::Get().Estimate(CostClass, CostSize);
+
+    UThreadTaskBase* Worker = this;
+    Body = [Worker, CostClass, CostSize, InnerBody = MoveTemp(Body)]() mutable
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        InnerBody();
+        // Canceled runs stop early and would skew the estimates.
+        if (IsValid(Worker) && !Worker->HasAnyFlags(RF_BeginDestroyed) && !Worker->IsUnreachable() && !Worker->IsCanceled())
+        {
+            FMultiTaskCostModel::Get().Record(CostClass, CostSize, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        }
+    };
+
+    if (IsValid(Group) && !Group->HasAnyFlags(RF_BeginDestroyed) && !Group->IsUnreachable())
+    {
+        TWeakObjectPtr<UMultiTaskGroup> WeakGroup(Group);
+        Group->OnWorkStarted();
+        OnCompleted = [WeakGroup, InnerOnCompleted = MoveTemp(OnCompleted)]() mutable
+        {
+            if (InnerOnCompleted)
+            {
+                InnerOnCompleted();
+            }
+            if (UMultiTaskGroup* LocalGroup = WeakGroup.Get())
+            {
+                LocalGroup->OnWorkFinished();
+            }
+        };
+    }
+
+    if (IsValid(Pipe) && !Pipe->HasAnyFlags(RF_BeginDestroyed) && !Pipe->IsUnreachable())
+    {
+        // The returned future completes when the work ran, the pipe only launches it once the previous work finished.
+        TSharedRef<TPromise<void>, ESPMode::ThreadSafe> PipePromise = MakeShared<TPromise<void>, ESPMode::ThreadSafe>(MoveTemp(OnCompleted));
+        TFuture<void> PipeFuture = PipePromise->GetFuture();
+        // The step may run after the Task is gone, it keeps a weak reference and the launch parameters of now.
+        TWeakObjectPtr<UThreadTaskBase> WeakWorker(this);
+        const ETaskExecutionType LaunchExecutionType = ExecutionType;
+        TWeakObjectPtr<UMultiTaskThreadPool> LaunchThreadPool(ThreadPool);
+        const EMultiTaskWorkPriority LaunchPriority = Priority;
+        const FName LaunchCoalesceKey = CoalesceKey;
+        Pipe->Push([WeakWorker, LaunchExecutionType, LaunchThreadPool, LaunchPriority, LaunchCoalesceKey, ExpectedCost, PipePromise, InnerBody = MoveTemp(Body)](TUniqueFunction<void()>&& OnStepFinished) mutable
+        {
+            UThreadTaskBase* LocalWorker = WeakWorker.Get();
+            if (!(IsValid(LocalWorker) && !LocalWorker->HasAnyFlags(RF_BeginDestroyed) && !LocalWorker->IsUnreachable()))
+            {
+                PipePromise->SetValue();
+                OnStepFinished();
+                return;
+            }
+            LocalWorker->LaunchDirect(MoveTemp(InnerBody), [PipePromise, OnStepFinished = MoveTemp(OnStepFinished)]() mutable
+            {
+                PipePromise->SetValue();
+                OnStepFinished();
+            }, ExpectedCost, LaunchExecutionType, LaunchThreadPool.Get(), LaunchPriority, LaunchCoalesceKey);
+        }, [WeakWorker, PipePromise]()
+        {
+            // Dropped before its turn, the Task takes the canceled branch.
+            UThreadTaskBase* LocalWorker = WeakWorker.Get();
+            if (IsValid(LocalWorker) && !LocalWorker->HasAnyFlags(RF_BeginDestroyed) && !LocalWorker->IsUnreachable() && !LocalWorker->IsCanceled())
+            {
+                LocalWorker->MarkCanceled();
+            }
+            PipePromise->SetValue();
+        }, this);
+        return PipeFuture;
+    }
+
+    return LaunchDirect(MoveTemp(Body), MoveTemp(OnCompleted), ExpectedCost, ExecutionType, ThreadPool, Priority, CoalesceKey);
+}
+
+TFuture<void> UThreadTaskBase::LaunchDirect(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, double ExpectedCost, ETaskExecutionType InExecutionType, UMultiTaskThreadPool* InThreadPool, EMultiTaskWorkPriority InPriority, FName InCoalesceKey)
+{
+    EAsyncExecution AsyncType = EAsyncExecution::ThreadPool;
+    switch (InExecutionType)
+    {
+    case ETaskExecutionType::TaskGraphHighPriority:
+        return LaunchOnTaskGraph(MoveTemp(Body), MoveTemp(OnCompleted), ENamedThreads::AnyHiPriThreadHiPriTask);
+    case ETaskExecutionType::TaskGraphBackground:
+        return LaunchOnTaskGraph(MoveTemp(Body), MoveTemp(OnCompleted), ENamedThreads::AnyBackgroundThreadNormalTask);
+    case ETaskExecutionType::Tasks:
+        return LaunchOnTasks(MoveTemp(Body), MoveTemp(OnCompleted), InPriority);
+    case ETaskExecutionType::TaskGraph:
+        AsyncType = EAsyncExecution::TaskGraph;
+        break;
+    case ETaskExecutionType::Thread:
+        AsyncType = EAsyncExecution::Thread;
+        break;
+    case ETaskExecutionType::ThreadPool:
+        AsyncType = EAsyncExecution::ThreadPool;
+        break;
+    }
+
+    if (AsyncType == EAsyncExecution::ThreadPool && InThreadPool && InThreadPool->GetThreadsNum() > 0)
+    {
+        // Rejected or replaced work takes the canceled branch.
+        TWeakObjectPtr<UThreadTaskBase> WeakWorker(this);
+        return InThreadPool->Launch(MoveTemp(Body), MoveTemp(OnCompleted), InPriority, ExpectedCost, InCoalesceKey, this, [WeakWorker]()
+        {
+            UThreadTaskBase* LocalWorker = WeakWorker.Get();
+            if (IsValid(LocalWorker) && !LocalWorker->HasAnyFlags(RF_BeginDestroyed) && !LocalWorker->IsUnreachable() && !LocalWorker->IsCanceled())
+            {
+                LocalWorker->MarkCanceled();
+            }
+        });
+    }
+    return Async(AsyncType, MoveTemp(Body), MoveTemp(OnCompleted));
+}
+
+TFuture<void> UThreadTaskBase::LaunchOnTaskGraph(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, ENamedThreads::Type Thread)
+{
+    TSharedRef<TPromise<void>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<void>, ESPMode::ThreadSafe>(MoveTemp(OnCompleted));
+    TFuture<void> Future = Promise->GetFuture();
+    FFunctionGraphTask::CreateAndDispatchWhenReady([Promise, Body = MoveTemp(Body)]() mutable
+    {
+        Body();
+        Promise->SetValue();
+    }, TStatId(), nullptr, Thread);
+    return Future;
+}
+
+TFuture<void> UThreadTaskBase::LaunchOnTasks(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, EMultiTaskWorkPriority WorkPriority)
+{
+    UE::Tasks::ETaskPriority TaskPriority = UE::Tasks::ETaskPriority::Normal;
+    switch (WorkPriority)
+    {
+    case EMultiTaskWorkPriority::Highest:
+    case EMultiTaskWorkPriority::High:
+        TaskPriority = UE::Tasks::ETaskPriority::High;
+        break;
+    case EMultiTaskWorkPriority::Normal:
+        TaskPriority = UE::Tasks::ETaskPriority::Normal;
+        break;
+    case EMultiTaskWorkPriority::Low:
+        TaskPriority = UE::Tasks::ETaskPriority::BackgroundHigh;
+        break;
+    case EMultiTaskWorkPriority::Lowest:
+        TaskPriority = UE::Tasks::ETaskPriority::BackgroundNormal;
+        break;
+    }
+
+    TSharedRef<TPromise<void>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<void>, ESPMode::ThreadSafe>(MoveTemp(OnCompleted));
+    TFuture<void> Future = Promise->GetFuture();
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Promise, Body = MoveTemp(Body)]() mutable
+    {
+        Body();
+        Promise->SetValue();
+    }, TaskPriority);
+    return Future;
+}
+
+void UThreadTaskBase::Cancel()
+{
+    Super::Cancel();
+    // Work still waiting for its turn on the Pipe would only launch to find the Task canceled.
+    if (IsValid(Pipe) && !Pipe->HasAnyFlags(RF_BeginDestroyed) && !Pipe->IsUnreachable())
+    {
+        Pipe->DropQueuedWork(this);
+    }
+}
+
+void UThreadTaskBase::OnLifetimeEnded()
+{
+    // Cancel also drops the queued Pipe steps.
+    Super::OnLifetimeEnded();
+    if (IsValid(ThreadPool) && !ThreadPool->HasAnyFlags(RF_BeginDestroyed) && !ThreadPool->IsUnreachable())
+    {
+        ThreadPool->DropQueuedWork(this);
+    }
+}
+
 void UThreadTaskBase::OnEndPIE(const bool bIsSimulating)
 {
     if (IsRunning())
@@ -4,6 +4,12 @@
 #include "MultiThreadTaskLibrary.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/InstancedStaticMesh.h"
+#include "Stats/Stats.h"
+
+// "stat MultiTask2" shows where large updates spend their time, workers and Game Thread separately.
+DECLARE_STATS_GROUP(TEXT("MultiTask2"), STATGROUP_MultiTask2, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Update Instances Chunk"), STAT_MultiTaskUpdateInstancesChunk, STATGROUP_MultiTask2);
+DECLARE_CYCLE_STAT(TEXT("Update Instances Apply"), STAT_MultiTaskUpdateInstancesApply, STATGROUP_MultiTask2);
 
 bool UUpdateInstancesTask::Start()
 {
@@ -75,23 +81,6 @@ bool UUpdateInstancesTask::Start()
 
     bCanceled = false;
 
-    EAsyncExecution AsyncType = EAsyncExecution::ThreadPool;
-    switch (ExecutionType)
-    {
-    case ETaskExecutionType::TaskGraph:
-        AsyncType = EAsyncExecution::TaskGraph;
-        break;
-    case ETaskExecutionType::Thread:
-        AsyncType = EAsyncExecution::Thread;
-        break;
-    case ETaskExecutionType::ThreadPool:
-        AsyncType = EAsyncExecution::ThreadPool;
-        break;
-    }
-
-    UnbuiltInstanceBounds.Init();
-    BuiltInstanceBounds.Init();
-
     HISMTransform = HISM->GetComponentTransform();
     MeshBounds = HISM->GetStaticMesh()->GetBounds().GetBox();
 
@@ -100,6 +89,16 @@ bool UUpdateInstancesTask::Start()
     const int32 LastChunkSize = MaxCount - (ChunkSize * TaskCount);
     const int32 Chunks = LastChunkSize > 0 ? TaskCount + 1 : TaskCount;
 
+    // Every chunk owns a disjoint region of the output buffers, sized for its worst case, so workers write in place without locking.
+    // Packed Custom Data forces a full tree rebuild from PerInstanceSMData, which makes per instance commands redundant.
+    const bool bRebuildTree = bPackedCustomData && CustomDataArraySize > 0;
+    CmdsPerInstance = bRebuildTree ? 0 : (TransformArraySize > 0 ? 1 : 0) + (GetCustomDataArraySize() > 0 && !bPackedCustomData ? 1 : 0);
+    Cmds.SetNumZeroed(MaxCount * CmdsPerInstance);
+    UnbuiltInstanceBoundsList.SetNumUninitialized(TransformArraySize);
+    ChunkResults.Reset();
+    ChunkResults.SetNum(Chunks);
+    UnbuiltInstancesNum = 0;
+
     UUpdateInstancesTask* Worker = this;
 
     Tasks.SetNumZeroed(Chunks);
@@ -117,13 +116,7 @@ bool UUpdateInstancesTask::Start()
             Worker->TaskBody(IterationSize, ChunkIndex, ChunkSize);
         };
 
-        if (AsyncType == EAsyncExecution::ThreadPool && ThreadPool && ThreadPool->GetThreadsNum() > 0)
-        {
-            Tasks[ChunkIndex] = AsyncPool(ThreadPool->Obj.ToSharedRef().Get(), TUniqueFunction<void()>(BodyFunc));
-        }
-        else {
-            Tasks[ChunkIndex] = Async(AsyncType, TUniqueFunction<void()>(BodyFunc));
-        }
+        Tasks[ChunkIndex] = LaunchWork(TUniqueFunction<void()>(BodyFunc), nullptr, IterationSize);
 
     }
 
@@ -138,15 +131,20 @@ int32 UUpdateInstancesTask::GetCustomDataArraySize() const
 
 void UUpdateInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32 ChunkSize)
 {
+    SCOPE_CYCLE_COUNTER(STAT_MultiTaskUpdateInstancesChunk);
     if (HISM->GetStaticMesh())
     {
-        TArray<FInstancedStaticMeshInstanceData> LocalPerInstanceSMData;
-        TArray<FInstanceUpdateCmdBuffer::FInstanceUpdateCommand> LocalCmds;
-        TArray<FBox> LocalUnbuiltInstanceBoundsList;
+        FUpdateInstancesChunkResult& ChunkResult = ChunkResults[ChunkIndex];
+        ChunkResult.FirstIndex = ChunkIndex * ChunkSize;
+
+        FInstanceUpdateCmdBuffer::FInstanceUpdateCommand* ChunkCmds = CmdsPerInstance > 0 ? Cmds.GetData() + ChunkResult.FirstIndex * CmdsPerInstance : nullptr;
+        FBox* ChunkUnbuiltInstanceBoundsList = ChunkResult.FirstIndex < TransformArraySize ? UnbuiltInstanceBoundsList.GetData() + ChunkResult.FirstIndex : nullptr;
         FBox LocalUnbuiltInstanceBounds;
         FBox LocalBuiltInstanceBounds;
         LocalUnbuiltInstanceBounds.Init();
         LocalBuiltInstanceBounds.Init();
+        int32 CmdsNum = 0;
+        int32 ChunkUnbuiltNum = 0;
 
         const int32 CustomDataArrSize = GetCustomDataArraySize();
         const int32 CustomDataSize = GetCustomDataSize(CustomDataType);
@@ -156,10 +154,10 @@ void UUpdateInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32
         {
             if (!(IsValid(HISM) && !HISM->HasAnyFlags(RF_BeginDestroyed) && !HISM->IsUnreachable() && !IsCanceled()))
             {
-                return;
+                break;
             }
 
-            const int32 CurrentIndex = (ChunkIndex * ChunkSize) + X;
+            const int32 CurrentIndex = ChunkResult.FirstIndex + X;
             const int32 InstanceIndex = StartIndex + CurrentIndex;
 
             if (!HISM->PerInstanceSMData.IsValidIndex(InstanceIndex))
@@ -185,11 +183,11 @@ void UUpdateInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32
                 const bool bDoInPlaceUpdate = bIsBuiltInstance && NewLocalLocation.Equals(OldTransform.GetOrigin()) && (HISM->PerInstanceRenderData.IsValid() && HISM->PerInstanceRenderData->InstanceBuffer.RequireCPUAccess);
                 const FBox NewInstanceBounds = MeshBounds.TransformBy(NewLocalTransform);
 
-                LocalPerInstanceSMData.Add(FInstancedStaticMeshInstanceData(NewMatrix));
+                PerInstanceSMData[CurrentIndex].Transform = NewMatrix;
 
-                if (!bIsOmittedInstance)
+                if (!bIsOmittedInstance && ChunkCmds)
                 {
-                    FInstanceUpdateCmdBuffer::FInstanceUpdateCommand& Cmd = LocalCmds.AddDefaulted_GetRef();
+                    FInstanceUpdateCmdBuffer::FInstanceUpdateCommand& Cmd = ChunkCmds[CmdsNum++];
                     Cmd.InstanceIndex = RenderIndex;
                     Cmd.Type = FInstanceUpdateCmdBuffer::Update;
                     Cmd.XForm = NewMatrix;
@@ -207,17 +205,17 @@ void UUpdateInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32
                 else
                 {
                     LocalUnbuiltInstanceBounds += NewInstanceBounds;
-                    LocalUnbuiltInstanceBoundsList.Add(NewInstanceBounds);
+                    ChunkUnbuiltInstanceBoundsList[ChunkUnbuiltNum++] = NewInstanceBounds;
                 }
             }
 
 
-            if (CurrentIndex < CustomDataArrSize && CustomDataArrSize > 0)
+            if (CurrentIndex < CustomDataArrSize && CustomDataArrSize > 0 && !bPackedCustomData)
             {
 
                 if (!bIsOmittedInstance)
                 {
-                    FInstanceUpdateCmdBuffer::FInstanceUpdateCommand& Cmd = LocalCmds.AddDefaulted_GetRef();
+                    FInstanceUpdateCmdBuffer::FInstanceUpdateCommand& Cmd = ChunkCmds[CmdsNum++];
                     Cmd.InstanceIndex = RenderIndex;
                     Cmd.Type = FInstanceUpdateCmdBuffer::CustomData;
                     Cmd.CustomDataFloats = TArray<float>(&CustomDataPtr[CurrentIndex * CustomDataSize], CustomDataSize);
@@ -225,22 +223,39 @@ void UUpdateInstancesTask::TaskBody(int32 IterationSize, int32 ChunkIndex, int32
             }
         }
 
-        Mutex.Lock();
-        if (LocalPerInstanceSMData.Num() > 0)
+        ChunkResult.BuiltInstanceBounds = LocalBuiltInstanceBounds;
+        ChunkResult.UnbuiltInstanceBounds = LocalUnbuiltInstanceBounds;
+        ChunkResult.CmdsNum = CmdsNum;
+        ChunkResult.UnbuiltInstancesNum = ChunkUnbuiltNum;
+    }
+}
+
+void UUpdateInstancesTask::ApplyChunkResults()
+{
+    SCOPE_CYCLE_COUNTER(STAT_MultiTaskUpdateInstancesApply);
+    check(IsInGameThread());
+    // Each chunk filled the front of its own region, only the used part is handed to the component.
+    for (const FUpdateInstancesChunkResult& ChunkResult : ChunkResults)
+    {
+        HISM->BuiltInstanceBounds += ChunkResult.BuiltInstanceBounds;
+        HISM->UnbuiltInstanceBounds += ChunkResult.UnbuiltInstanceBounds;
+        if (ChunkResult.UnbuiltInstancesNum > 0)
         {
-            FMemory::Memcpy(&PerInstanceSMData[ChunkIndex * ChunkSize], LocalPerInstanceSMData.GetData(), sizeof(FInstancedStaticMeshInstanceData) * LocalPerInstanceSMData.Num());
-            BuiltInstanceBounds += LocalBuiltInstanceBounds;
-            UnbuiltInstanceBounds += LocalUnbuiltInstanceBounds;
-            UnbuiltInstanceBoundsList.Append(LocalUnbuiltInstanceBoundsList);
+            HISM->UnbuiltInstanceBoundsList.Append(UnbuiltInstanceBoundsList.GetData() + ChunkResult.FirstIndex, ChunkResult.UnbuiltInstancesNum);
+            UnbuiltInstancesNum += ChunkResult.UnbuiltInstancesNum;
         }
-
-        if (LocalCmds.Num() > 0)
+        if (ChunkResult.CmdsNum > 0)
         {
-            Cmds.Append(LocalCmds);
+            FInstanceUpdateCmdBuffer::FInstanceUpdateCommand* ChunkCmds = Cmds.GetData() + ChunkResult.FirstIndex * CmdsPerInstance;
+            HISM->InstanceUpdateCmdBuffer.Cmds.Reserve(HISM->InstanceUpdateCmdBuffer.Cmds.Num() + ChunkResult.CmdsNum);
+            for (int32 CmdIndex = 0; CmdIndex < ChunkResult.CmdsNum; ++CmdIndex)
+            {
+                HISM->InstanceUpdateCmdBuffer.Cmds.Add(MoveTemp(ChunkCmds[CmdIndex]));
+            }
+            HISM->InstanceUpdateCmdBuffer.NumEdits += ChunkResult.CmdsNum;
         }
-
-        Mutex.Unlock();
     }
+    ChunkResults.Empty();
 }
 
 void UUpdateInstancesTask::UpdatePhysicsBodies()
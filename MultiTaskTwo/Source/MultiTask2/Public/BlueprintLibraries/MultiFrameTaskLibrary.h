@@ -2,8 +2,12 @@
 #pragma once
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "MultiTaskBase.h"
+#include "MultiFrameGridWalker.h"
 #include "MultiFrameTaskLibrary.generated.h"
 
+class UMultiFrameTaskScheduler;
+class UMultiTaskThreadPool;
+
 UCLASS()
 class MULTITASK2_API UMultiFrameTaskLibrary : public UBlueprintFunctionLibrary
 {
@@ -14,10 +18,11 @@ public:
 	* This executes on Game Thread.
 	* @param IterationsPerTick	The amount of iterations processed per frame.
 	* @param Delay				Amount of seconds to wait after IterationsPerTick is reached.
+	* @param TimeBudget			Milliseconds of iterations per frame. When higher than 0 it replaces IterationsPerTick.
 	* @param Task				Running Task.
     */
 	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Multi-Frame", Meta = (DisplayName = "Do Async Task", Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", DeterminesOutputType = "Class", DynamicOutputParam = "Task"))
-		static void DoAsyncTask(UObject* WorldContextObject, EMultiTask2BranchesNoCompleteWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameAsyncTask> Class, UMultiFrameAsyncTask*& Task, int32 IterationsPerTick = 1, float Delay = 0.0f);
+		static void DoAsyncTask(UObject* WorldContextObject, EMultiTask2BranchesNoCompleteWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameAsyncTask> Class, UMultiFrameAsyncTask*& Task, int32 IterationsPerTick = 1, float Delay = 0.0f, float TimeBudget = 0.0f);
 
 	/**
 	* Spread a 1D Loop over multiple frames.
@@ -25,10 +30,11 @@ public:
 	* @param XSize				X Dimension size.
 	* @param IterationsPerTick	The amount of iterations processed per frame.
 	* @param Delay				Amount of seconds to wait after IterationsPerTick is reached.
+	* @param TimeBudget			Milliseconds of iterations per frame. When higher than 0 it replaces IterationsPerTick.
 	* @param Task				Running Task.
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Multi-Frame", Meta = (DisplayName = "Do Loop 1D Task", Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", DeterminesOutputType = "Class", DynamicOutputParam = "Task"))
-		static void DoLoop1DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop1DTask> Class, int32& X, UMultiFrameLoop1DTask*& Task, int32 XSize = 1, int32 IterationsPerTick = 1, float Delay = 0.0f);
+		static void DoLoop1DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop1DTask> Class, int32& X, UMultiFrameLoop1DTask*& Task, int32 XSize = 1, int32 IterationsPerTick = 1, float Delay = 0.0f, float TimeBudget = 0.0f);
 
 	/**
     * Spread a 2D Loop over multiple frames.
@@ -37,10 +43,13 @@ public:
     * @param YSize				Y Dimension size.
     * @param IterationsPerTick	The amount of iterations processed per frame.
     * @param Delay				Amount of seconds to wait after IterationsPerTick is reached.
+    * @param TimeBudget			Milliseconds of iterations per frame. When higher than 0 it replaces IterationsPerTick.
+    * @param IterationOrder		Order in which cells are visited.
+    * @param TileSize			Side of the tiles of the Tiled order.
 	* @param Task				Running Task.
     */
 	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Multi-Frame", Meta = (DisplayName = "Do Loop 2D Task", Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", DeterminesOutputType = "Class", DynamicOutputParam = "Task"))
-		static void DoLoop2DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop2DTask> Class, int32& X, int32& Y, UMultiFrameLoop2DTask*& Task, int32 XSize = 1, int32 YSize = 1, int32 IterationsPerTick = 1, float Delay = 0.0f);
+		static void DoLoop2DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop2DTask> Class, int32& X, int32& Y, UMultiFrameLoop2DTask*& Task, int32 XSize = 1, int32 YSize = 1, int32 IterationsPerTick = 1, float Delay = 0.0f, float TimeBudget = 0.0f, EMultiFrameLoopOrder IterationOrder = EMultiFrameLoopOrder::Linear, int32 TileSize = 8);
 
 	/**
 	* Spread a 3D Loop over multiple frames.
@@ -50,9 +59,77 @@ public:
 	* @param ZSize				Z Dimension size.
 	* @param IterationsPerTick	The amount of iterations processed per frame.
 	* @param Delay				Amount of seconds to wait after IterationsPerTick is reached.
+	* @param TimeBudget			Milliseconds of iterations per frame. When higher than 0 it replaces IterationsPerTick.
+	* @param IterationOrder		Order in which cells are visited.
+	* @param TileSize			Side of the tiles of the Tiled order.
 	* @param Task				Running Task.
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Multi-Frame", Meta = (DisplayName = "Do Loop 3D Task", Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", DeterminesOutputType = "Class", DynamicOutputParam = "Task"))
-		static void DoLoop3DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop3DTask> Class, int32& X, int32& Y, int32& Z, UMultiFrameLoop3DTask*& Task, int32 XSize = 1, int32 YSize = 1, int32 ZSize = 1, int32 IterationsPerTick = 1, float Delay = 0.0f);
+		static void DoLoop3DTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoop3DTask> Class, int32& X, int32& Y, int32& Z, UMultiFrameLoop3DTask*& Task, int32 XSize = 1, int32 YSize = 1, int32 ZSize = 1, int32 IterationsPerTick = 1, float Delay = 0.0f, float TimeBudget = 0.0f, EMultiFrameLoopOrder IterationOrder = EMultiFrameLoopOrder::Linear, int32 TileSize = 8);
+
+	/**
+	* Spread a Loop over multiple frames, calling the body once per batch of contiguous indices.
+	* Cheaper than one call per index when the body can process a span, e.g. a row of a grid.
+	* This executes on Game Thread.
+	* @param FirstX				First X index of the current batch.
+	* @param LastX				Last X index of the current batch, inclusive. Batches never cross rows.
+	* @param XSize				X Dimension size.
+	* @param YSize				Y Dimension size.
+	* @param ZSize				Z Dimension size.
+	* @param BatchSize			Maximum amount of indices per batch.
+	* @param IterationsPerTick	The amount of batches processed per frame.
+	* @param Delay				Amount of seconds to wait after IterationsPerTick is reached.
+	* @param TimeBudget			Milliseconds of iterations per frame. When higher than 0 it replaces IterationsPerTick.
+	* @param Task				Running Task.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Multi-Frame", Meta = (DisplayName = "Do Loop Batch Task", Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", DeterminesOutputType = "Class", DynamicOutputParam = "Task"))
+		static void DoLoopBatchTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameLoopBatchTask> Class, int32& FirstX, int32& LastX, int32& Y, int32& Z, UMultiFrameLoopBatchTask*& Task, int32 XSize = 1, int32 YSize = 1, int32 ZSize = 1, int32 BatchSize = 64, int32 IterationsPerTick = 1, float Delay = 0.0f, float TimeBudget = 0.0f);
+
+	/**
+	* Spread a Loop over multiple frames and run each frame's slice in parallel on worker threads.
+	* The Task Body of the Task class runs on the workers and must be thread safe. On Task Body fires on Game Thread once per slice,
+	* after every index of the slice was processed, with the linear range of the slice.
+	* @param FirstIndex			First linear index of the joined slice.
+	* @param LastIndex			Last linear index of the joined slice, inclusive.
+	* @param XSize				X Dimension size.
+	* @param YSize				Y Dimension size.
+	* @param ZSize				Z Dimension size.
+	* @param SliceSize			Amount of indices processed in parallel between two Game Thread sync points.
+	* @param Delay				Amount of seconds to wait between slices.
+	* @param ThreadPool			Thread Pool running the slices. If Null, the Task Graph workers are used.
+	* @param Task				Running Task.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Multi-Frame", Meta = (DisplayName = "Do Parallel Loop Task", Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", DeterminesOutputType = "Class", DynamicOutputParam = "Task"))
+		static void DoParallelLoopTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameParallelLoopTask> Class, int32& FirstIndex, int32& LastIndex, UMultiFrameParallelLoopTask*& Task, int32 XSize = 1, int32 YSize = 1, int32 ZSize = 1, int32 SliceSize = 1024, float Delay = 0.0f, UMultiTaskThreadPool* ThreadPool = nullptr);
+
+	/**
+	* Spread a Loop over multiple frames, visiting only the selected cells of a grid.
+	* Every index of Indices is visited first, then every set bit of Mask. Words of Mask without set bits are skipped as a whole,
+	* so the cost is proportional to the amount of selected cells rather than to the size of the grid.
+	* This executes on Game Thread.
+	* @param Index				Linear index, X + Y * XSize + Z * XSize * YSize.
+	* @param Indices			Linear indices to visit. Negative indices are skipped.
+	* @param Mask				Bit mask of linear indices to visit, 64 per word. See Set Mask Bit.
+	* @param XSize				X Dimension size.
+	* @param YSize				Y Dimension size.
+	* @param IterationsPerTick	The amount of iterations processed per frame.
+	* @param Delay				Amount of seconds to wait after IterationsPerTick is reached.
+	* @param TimeBudget			Milliseconds of iterations per frame. When higher than 0 it replaces IterationsPerTick.
+	* @param Task				Running Task.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Multi-Frame", Meta = (DisplayName = "Do Sparse Loop Task", Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", DeterminesOutputType = "Class", DynamicOutputParam = "Task", AutoCreateRefTerm = "Indices,Mask"))
+		static void DoSparseLoopTask(UObject* WorldContextObject, EMultiTask2BranchesWithBody& Out, FLatentActionInfo LatentInfo, TSubclassOf<class UMultiFrameSparseLoopTask> Class, int32& Index, int32& X, int32& Y, int32& Z, UMultiFrameSparseLoopTask*& Task, const TArray<int32>& Indices, const TArray<int64>& Mask, int32 XSize = 1, int32 YSize = 1, int32 IterationsPerTick = 1, float Delay = 0.0f, float TimeBudget = 0.0f);
+
+	/**
+	* Set or clear the bit of a linear index in a mask used by Do Sparse Loop Task. The mask grows as needed.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Multi Task 2|Multi-Frame")
+		static void SetMaskBit(UPARAM(ref) TArray<int64>& Mask, int32 Index, bool bValue = true);
+
+	/**
+	* Returns the Scheduler serving all Multi-Frame Tasks. Its Frame Budget caps the Game Thread time they use together.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Multi Task 2|Multi-Frame")
+		static UMultiFrameTaskScheduler* GetMultiFrameScheduler();
 
-};
\ No newline at end of file
+};
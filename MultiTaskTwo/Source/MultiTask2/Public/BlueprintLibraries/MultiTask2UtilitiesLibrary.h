@@ -144,4 +144,6 @@ public:
     static int32 TaskIndex;
     static int32 MutexIndex;
     static int32 ThreadPoolIndex;
+    static int32 GroupIndex;
+    static int32 SyncObjectIndex;
 };
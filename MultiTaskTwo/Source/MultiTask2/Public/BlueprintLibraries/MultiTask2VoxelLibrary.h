@@ -4,6 +4,7 @@
 #include "MultiThreadTask.h"
 #include "MultiTaskThreadPool.h"
 #include "GenerateMarchingCubesTask.h"
+#include "MultiTaskBuffers.h"
 #include "Components/StaticMeshComponent.h"
 #include "MultiTask2VoxelLibrary.generated.h"
 
@@ -194,4 +195,22 @@ public:
 	*/
 	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Convert VoxelData To MeshData Task", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", AutoCreateRefTerm = "SimplifierSettings", DeterminesOutputType = "Class", DynamicOutputParam = "Task"), Category = "Multi Task 2|Marching Cubes")
 		static void DoConvertVoxelDataToMeshDataTask(UObject* WorldContextObject, FLatentActionInfo LatentInfo, TSubclassOf<class UGenerateMarchingCubesTask> Class, const FIntVector& ChunkSlot, const FMarchingCubesSettings& Settings, EMarchingCubesNormal NormalType, bool bUseFlatShading, UPARAM(ref)FMarchingCubesData& VoxelData, const TArray<FMarchingCubesSimplifierSettings>& SimplifierSettings, UGenerateMarchingCubesTask*& Task, TArray<FMarchingCubesMeshData>& MeshData, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
+
+	/**
+	* Convert Marching Cubes Geometry to Renderable geometry held by an immutable Mesh Data Buffer.
+	* The buffer can be handed to other nodes and Tasks without copying the geometry.
+	* @param Class				Task Class to be executed.
+	* @param ChunkSlot			{X, Y, Z} coordinates of the geometry in the chunk grid. If not using a chunk system, could use {1, 1, 1}.
+	* @param Settings			Generic settings for Marching Cubes algorithm.
+	* @param NormalType			Normal algorithm to be used when generating Mesh Data
+	* @param bUseFlatShading	Whether Normals use flat shading.
+	* @param VoxelData			Marching Cubes Geometry to convert to Renderable Geometry.
+	* @param Task				Running Task.
+	* @param SimplifierSettings	LOD Settings.
+	* @param MeshData			Generated Renderable Geometry, one entry per LOD.
+	* @param ExecutionType		Execution type.
+	* @param ThreadPool			Thread Pool to be used. If Null and ExecutionType is ThreadPool, then the engine's internal Thread Pool will be used.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Convert VoxelData To MeshData Buffer Task", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", AutoCreateRefTerm = "SimplifierSettings", DeterminesOutputType = "Class", DynamicOutputParam = "Task"), Category = "Multi Task 2|Marching Cubes")
+		static void DoConvertVoxelDataToMeshDataBufferTask(UObject* WorldContextObject, FLatentActionInfo LatentInfo, TSubclassOf<class UGenerateMarchingCubesTask> Class, const FIntVector& ChunkSlot, const FMarchingCubesSettings& Settings, EMarchingCubesNormal NormalType, bool bUseFlatShading, UPARAM(ref)FMarchingCubesData& VoxelData, const TArray<FMarchingCubesSimplifierSettings>& SimplifierSettings, UGenerateMarchingCubesTask*& Task, FMultiTaskMeshDataBuffer& MeshData, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
 };
\ No newline at end of file
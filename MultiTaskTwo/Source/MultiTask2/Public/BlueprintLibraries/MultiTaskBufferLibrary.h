@@ -0,0 +1,98 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "MultiTaskBuffers.h"
+#include "MultiTaskBufferLibrary.generated.h"
+
+/**
+* Immutable buffers are passed between nodes by handle, only Make and To Array copy the elements.
+*/
+UCLASS()
+class MULTITASK2_API UMultiTaskBufferLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    /**
+    * Create a Transform Buffer. The elements are copied once, every later handoff shares them.
+    */
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Make Transform Buffer"), Category = "Multi Task 2|Buffers")
+    static FMultiTaskTransformBuffer MakeTransformBuffer(const TArray<FTransform>& Transforms);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "To Array (Transform Buffer)"), Category = "Multi Task 2|Buffers")
+    static TArray<FTransform> TransformBufferToArray(const FMultiTaskTransformBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Length (Transform Buffer)"), Category = "Multi Task 2|Buffers")
+    static int32 TransformBufferLength(const FMultiTaskTransformBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Get (Transform Buffer)"), Category = "Multi Task 2|Buffers")
+    static FTransform TransformBufferGet(const FMultiTaskTransformBuffer& Buffer, int32 Index);
+
+    //---------------------------------------------------------
+
+    /**
+    * Create a Float Buffer. The elements are copied once, every later handoff shares them.
+    */
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Make Float Buffer"), Category = "Multi Task 2|Buffers")
+    static FMultiTaskFloatBuffer MakeFloatBuffer(const TArray<float>& Floats);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "To Array (Float Buffer)"), Category = "Multi Task 2|Buffers")
+    static TArray<float> FloatBufferToArray(const FMultiTaskFloatBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Length (Float Buffer)"), Category = "Multi Task 2|Buffers")
+    static int32 FloatBufferLength(const FMultiTaskFloatBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Get (Float Buffer)"), Category = "Multi Task 2|Buffers")
+    static float FloatBufferGet(const FMultiTaskFloatBuffer& Buffer, int32 Index);
+
+    //---------------------------------------------------------
+
+    /**
+    * Create a Vector Buffer. The elements are copied once, every later handoff shares them.
+    */
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Make Vector Buffer"), Category = "Multi Task 2|Buffers")
+    static FMultiTaskVectorBuffer MakeVectorBuffer(const TArray<FVector>& Vectors);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "To Array (Vector Buffer)"), Category = "Multi Task 2|Buffers")
+    static TArray<FVector> VectorBufferToArray(const FMultiTaskVectorBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Length (Vector Buffer)"), Category = "Multi Task 2|Buffers")
+    static int32 VectorBufferLength(const FMultiTaskVectorBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Get (Vector Buffer)"), Category = "Multi Task 2|Buffers")
+    static FVector VectorBufferGet(const FMultiTaskVectorBuffer& Buffer, int32 Index);
+
+    //---------------------------------------------------------
+
+    /**
+    * Create a Byte Buffer. The elements are copied once, every later handoff shares them.
+    */
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Make Byte Buffer"), Category = "Multi Task 2|Buffers")
+    static FMultiTaskByteBuffer MakeByteBuffer(const TArray<uint8>& Bytes);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "To Array (Byte Buffer)"), Category = "Multi Task 2|Buffers")
+    static TArray<uint8> ByteBufferToArray(const FMultiTaskByteBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Length (Byte Buffer)"), Category = "Multi Task 2|Buffers")
+    static int32 ByteBufferLength(const FMultiTaskByteBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Get (Byte Buffer)"), Category = "Multi Task 2|Buffers")
+    static uint8 ByteBufferGet(const FMultiTaskByteBuffer& Buffer, int32 Index);
+
+    //---------------------------------------------------------
+
+    /**
+    * Create a Mesh Data Buffer. The elements are copied once, every later handoff shares them.
+    */
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Make Mesh Data Buffer"), Category = "Multi Task 2|Buffers")
+    static FMultiTaskMeshDataBuffer MakeMeshDataBuffer(const TArray<FMarchingCubesMeshData>& MeshData);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "To Array (Mesh Data Buffer)"), Category = "Multi Task 2|Buffers")
+    static TArray<FMarchingCubesMeshData> MeshDataBufferToArray(const FMultiTaskMeshDataBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Length (Mesh Data Buffer)"), Category = "Multi Task 2|Buffers")
+    static int32 MeshDataBufferLength(const FMultiTaskMeshDataBuffer& Buffer);
+
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Get (Mesh Data Buffer)"), Category = "Multi Task 2|Buffers")
+    static FMarchingCubesMeshData MeshDataBufferGet(const FMultiTaskMeshDataBuffer& Buffer, int32 Index);
+};
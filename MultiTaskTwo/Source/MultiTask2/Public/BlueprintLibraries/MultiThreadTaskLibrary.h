@@ -7,10 +7,23 @@
 #include "ProceduralMeshComponent.h"
 #include "DelaunayTriangulation2DTask.h"
 #include "MultiTask2VoxelLibrary.h"
+#include "MultiTaskBuffers.h"
 #include "MultiThreadTaskLibrary.generated.h"
 
 class UTexture;
 class UMultiTaskMutex;
+class UMultiTaskGroup;
+class UMultiTaskBarrier;
+class UMultiTaskLatch;
+class UMultiTaskSemaphore;
+class UMultiTaskPipe;
+class UMultiTaskCommandBuffer;
+class UMultiTaskConcurrentMap;
+class UMultiTaskConcurrentSet;
+class UMultiTaskConcurrentArray;
+class UMultiTaskTransformResultBuffer;
+class UMultiTaskFloatResultBuffer;
+class UMultiTaskVectorResultBuffer;
 class UHierarchicalInstancedStaticMeshComponent;
 
 UCLASS()
@@ -66,6 +79,21 @@ public:
 	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Spawn Instances", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", Chunks = "1", bCreatePhysicsBodies = "true"), Category = "Multi Task 2|Threading")
 		static void DoSpawnInstances(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, const TArray<FTransform>& Transforms, int32 Chunks, bool bWorldSpace, bool bCreatePhysicsBodies, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, TArray<int32>& NewInstances, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
 
+	/**
+	* Spawn HISM Instances from an immutable Transform Buffer using parallel(optional) multi-threading.
+	* The Task shares the buffer instead of copying it, and the buffer can't change while the Task is running.
+	* @param HISM						HISM Component.
+	* @param Transforms					Transforms for the instances that are going to be spawned.
+	* @param Chunks						Split the work into the specified amount of chunks. Values higher than 1 enable parallelism.
+	* @param bWorldSpace				Whether the provided transforms are in World Space.
+	* @param bCreatePhysicsBodies		With Collision enabled, Instance Physics Bodies get automatically updated on Game Thread.
+	* @param Task						Running Task.
+	* @param ExecutionType				Execution type.
+	* @param ThreadPool					Thread Pool to be used. If Null and ExecutionType is ThreadPool, then the engine's internal Thread Pool will be used.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Spawn Instances From Buffer", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", Chunks = "1", bCreatePhysicsBodies = "true"), Category = "Multi Task 2|Threading")
+		static void DoSpawnInstancesFromBuffer(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, const FMultiTaskTransformBuffer& Transforms, int32 Chunks, bool bWorldSpace, bool bCreatePhysicsBodies, UMultiTaskBase*& Task, TArray<int32>& NewInstances, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
+
 	/**
 	* Update HISM Instances and Custom Data using parallel(optional) multi-threading.
 	* @param HISM						HISM Component.
@@ -81,9 +109,10 @@ public:
 	* @param Task						Running Task.
 	* @param ExecutionType				Execution type.
 	* @param ThreadPool					Thread Pool to be used. If Null and ExecutionType is ThreadPool, then the engine's internal Thread Pool will be used.
+	* @param bPackedCustomData			Write Custom Data as one contiguous block and rebuild the instance tree once instead of sending a command per instance. Faster when most instances change. Transforms are picked up by the same rebuild.
 	*/
 	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Update Instances", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", Chunks = "1", bUpdatePhysicsBodies = "true", AutoCreateRefTerm = "Transforms, CustomData"), Category = "Multi Task 2|Threading")
-		static void DoUpdateInstances(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<float>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
+		static void DoUpdateInstances(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<float>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr, bool bPackedCustomData = false);
 
 	/**
 	* Update HISM Instances and Custom Data using parallel(optional) multi-threading.
@@ -100,9 +129,10 @@ public:
 	* @param Task						Running Task.
 	* @param ExecutionType				Execution type.
 	* @param ThreadPool					Thread Pool to be used. If Null and ExecutionType is ThreadPool, then the engine's internal Thread Pool will be used.
+	* @param bPackedCustomData			Write Custom Data as one contiguous block and rebuild the instance tree once instead of sending a command per instance. Faster when most instances change. Transforms are picked up by the same rebuild.
 	*/
 	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Update Instances 2", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", Chunks = "1", bUpdatePhysicsBodies = "true", AutoCreateRefTerm = "Transforms, CustomData"), Category = "Multi Task 2|Threading")
-		static void DoUpdateInstances2(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector2D>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
+		static void DoUpdateInstances2(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector2D>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr, bool bPackedCustomData = false);
 
 	/**
 	* Update HISM Instances and Custom Data using parallel(optional) multi-threading.
@@ -119,9 +149,10 @@ public:
 	* @param Task						Running Task.
 	* @param ExecutionType				Execution type.
 	* @param ThreadPool					Thread Pool to be used. If Null and ExecutionType is ThreadPool, then the engine's internal Thread Pool will be used.
+	* @param bPackedCustomData			Write Custom Data as one contiguous block and rebuild the instance tree once instead of sending a command per instance. Faster when most instances change. Transforms are picked up by the same rebuild.
 	*/
 	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Update Instances 3", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", Chunks = "1", bUpdatePhysicsBodies = "true", AutoCreateRefTerm = "Transforms, CustomData"), Category = "Multi Task 2|Threading")
-		static void DoUpdateInstances3(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
+		static void DoUpdateInstances3(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr, bool bPackedCustomData = false);
 
 	/**
 	* Update HISM Instances and Custom Data using parallel(optional) multi-threading.
@@ -138,9 +169,10 @@ public:
 	* @param Task						Running Task.
 	* @param ExecutionType				Execution type.
 	* @param ThreadPool					Thread Pool to be used. If Null and ExecutionType is ThreadPool, then the engine's internal Thread Pool will be used.
+	* @param bPackedCustomData			Write Custom Data as one contiguous block and rebuild the instance tree once instead of sending a command per instance. Faster when most instances change. Transforms are picked up by the same rebuild.
 	*/
 	UFUNCTION(BlueprintCallable, Meta = (Latent, DisplayName = "Do Update Instances 4", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Out", HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", Chunks = "1", bUpdatePhysicsBodies = "true", AutoCreateRefTerm = "Transforms, CustomData"), Category = "Multi Task 2|Threading")
-		static void DoUpdateInstances4(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector4>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr);
+		static void DoUpdateInstances4(UObject* WorldContextObject, FLatentActionInfo LatentInfo, UHierarchicalInstancedStaticMeshComponent* HISM, int32 StartIndex, const TArray<FTransform>& Transforms, const TArray<FVector4>& CustomData, int32 Chunks, bool bWorldSpace, bool bTeleport, bool bUpdatePhysicsBodies, bool bMarkRenderStateDirty, bool bCreateInternalDataCopies, UMultiTaskBase*& Task, EMultiTask2Branches& Out, ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool, UMultiTaskThreadPool* ThreadPool = nullptr, bool bPackedCustomData = false);
 
 	/**
 	* Triangulate an array of 2D points.
@@ -177,6 +209,31 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
 		static UMultiTaskThreadPool* CreateThreadPool(UObject* WorldContextObject, int32 NumQueuedThreads = 1, int32 StackSize = 32768, EMultiTaskThreadPriority ThreadPriority = EMultiTaskThreadPriority::Normal, FString Name = "UnknownThreadPool");
+	/**
+	 * Returns a Thread Pool created at startup from the Multi Task 2 project settings.
+	 *
+	 * @param Name Name of the Thread Pool as set in the project settings
+	 * @return ThreadPool Object. Null if there is no Thread Pool with that name
+	 */
+	UFUNCTION(BlueprintPure, Category = "Multi Task 2|Threading")
+		static UMultiTaskThreadPool* GetThreadPoolByName(FName Name);
+
+	/**
+	 * Learned execution time of a Task class for the specified input size.
+	 *
+	 * @param Class Task Class
+	 * @param WorkSize Input size, e.g. the amount of instances or voxels
+	 * @return Expected time in milliseconds, negative if there are no samples for this class yet
+	 */
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Multi Task 2|Threading|Utilities")
+		static float GetExpectedTaskCost(TSubclassOf<class UThreadTaskBase> Class, int32 WorkSize);
+
+	/**
+	 * Forget all learned execution times.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Multi Task 2|Threading|Utilities")
+		static void ResetTaskCostModel();
+
 	/**
 	 * Attempts to destroy a Thread Pool immediately.
 	 *
@@ -191,6 +248,90 @@ public:
 	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
 		static UMultiTaskMutex* CreateMutex(UObject* WorldContextObject);
 
+	/**
+	* Creates a Task Group Object.
+	* Add Tasks to the group before they start to wait for or cancel all of them at once.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskGroup* CreateTaskGroup(UObject* WorldContextObject);
+
+	/**
+	* Creates a reusable Barrier Object. Waiting threads are parked, not spinning.
+	* @param Participants	Amount of threads that must arrive before the barrier opens.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskBarrier* CreateBarrier(UObject* WorldContextObject, int32 Participants = 2);
+
+	/**
+	* Creates a single use Latch Object. Waiting threads are parked, not spinning.
+	* @param Count	Amount of Count Down calls needed to release the latch.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskLatch* CreateLatch(UObject* WorldContextObject, int32 Count = 1);
+
+	/**
+	* Creates a Semaphore Object. Waiting threads are parked, not spinning.
+	* @param InitialCount	Amount of permits available at creation.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskSemaphore* CreateSemaphore(UObject* WorldContextObject, int32 InitialCount = 1);
+
+	/**
+	* Creates a Pipe Object. Assign it to the Pipe of Tasks sharing a resource so they run one at a time in launch order,
+	* without blocking worker threads the way a Mutex does.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskPipe* CreatePipe(UObject* WorldContextObject);
+
+	/**
+	* Returns the Command Buffer shared by all Tasks. Task Bodies append Game Thread work to it, the buffer executes it once per frame.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Multi Task 2|Threading")
+		static UMultiTaskCommandBuffer* GetCommandBuffer();
+
+	/**
+	* Creates a Command Buffer with its own frame budget.
+	* @param FrameBudget	Game Thread time in milliseconds spent executing commands per frame. 0 executes every pending command.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskCommandBuffer* CreateCommandBuffer(UObject* WorldContextObject, float FrameBudget = 1.0f);
+
+	/**
+	* Creates a Concurrent Map. Parallel Tasks can publish results to it without a global lock.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskConcurrentMap* CreateConcurrentMap(UObject* WorldContextObject);
+
+	/**
+	* Creates a Concurrent Set.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskConcurrentSet* CreateConcurrentSet(UObject* WorldContextObject);
+
+	/**
+	* Creates an append only Concurrent Array with stable indices.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskConcurrentArray* CreateConcurrentArray(UObject* WorldContextObject);
+
+	/**
+	* Creates a Transform Result Buffer. One worker publishes a result per frame while Game Thread acquires the latest one, without locks or copies.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskTransformResultBuffer* CreateTransformResultBuffer(UObject* WorldContextObject);
+
+	/**
+	* Creates a Float Result Buffer. One worker publishes a result per frame while Game Thread acquires the latest one, without locks or copies.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskFloatResultBuffer* CreateFloatResultBuffer(UObject* WorldContextObject);
+
+	/**
+	* Creates a Vector Result Buffer. One worker publishes a result per frame while Game Thread acquires the latest one, without locks or copies.
+	*/
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject"), Category = "Multi Task 2|Threading")
+		static UMultiTaskVectorResultBuffer* CreateVectorResultBuffer(UObject* WorldContextObject);
+
 	/**
 	* Put a thread to sleep for the amount of seconds.
 	* @param Seconds Amount of seconds to sleep.
@@ -0,0 +1,87 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Tickable.h"
+#include "Engine/EngineBaseTypes.h"
+#include "MultiFrameTaskScheduler.generated.h"
+
+class UMultiFrameTaskBase;
+class UMultiFrameTaskScheduler;
+
+/**
+* Serves the Multi-Frame Tasks of one world that asked for a specific Tick Group.
+*/
+struct FMultiFrameSchedulerTickFunction : public FTickFunction
+{
+	UMultiFrameTaskScheduler* Scheduler = nullptr;
+	TWeakObjectPtr<UWorld> World;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+/**
+* Runs every Multi-Frame Task from a single tick.
+* Tasks are served by Priority, then by how long they waited, until the shared Frame Budget is spent.
+* This bounds the Game Thread cost of all running Multi-Frame Tasks together instead of letting each one add its own.
+* Tasks using a Tick Group are served from a tick function registered in that group of their world, the others at the end of the frame.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiFrameTaskScheduler : public UObject, public FTickableGameObject
+{
+	friend struct FMultiFrameSchedulerTickFunction;
+	GENERATED_BODY()
+public:
+	/**
+	* Start serving Task every frame until it is no longer running.
+	*/
+	void Register(UMultiFrameTaskBase* Task);
+
+	/**
+	* Amount of Multi-Frame Tasks currently served.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Multi-Frame Scheduler")
+		int32 GetTasksNum();
+
+	virtual void BeginDestroy() override;
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual bool IsTickableInEditor() const override;
+	virtual TStatId GetStatId() const override;
+
+public:
+	/**
+	* Game Thread time in milliseconds shared by all Multi-Frame Tasks per frame, across every Tick Group. Opt-in, 0 (default) lets every Task
+	* run its own Iterations Per Tick or Time Budget. With a budget, a Task may stop before its Iterations Per Tick: the clock is checked every
+	* Time Check Interval iterations, so the budget can be exceeded by that many iterations. Tasks not served in time carry over to the next frame,
+	* ahead of the ones served this frame.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0.0", UIMin = "0.0"), Category = "Multi-Frame Scheduler")
+		float FrameBudget = 0.0f;
+
+private:
+	static bool CanServe(const UMultiFrameTaskBase* Task);
+
+	/**
+	* Serve the Tasks of World in Group, or the Tasks without a Tick Group when World is null.
+	*/
+	void Serve(float DeltaTime, UWorld* World, ETickingGroup Group);
+	static bool IsServedBy(const UMultiFrameTaskBase* Task, UWorld* World, ETickingGroup Group);
+
+	void EnsureTickFunction(UWorld* World, ETickingGroup Group);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	TArray<TWeakObjectPtr<UMultiFrameTaskBase>> Tasks;
+	uint64 FrameCounter = 0;
+
+	// Budget already spent by earlier ticks of the same engine frame.
+	uint64 BudgetFrame = 0;
+	double BudgetSpent = 0.0;
+
+	TArray<TUniquePtr<FMultiFrameSchedulerTickFunction>> TickFunctions;
+	FDelegateHandle WorldCleanupHandle;
+};
@@ -4,11 +4,35 @@
 
 #include "Modules/ModuleManager.h"
 
-class FMultiTask2Module : public IModuleInterface
+class UMultiTaskThreadPool;
+class UMultiTaskCommandBuffer;
+class UMultiFrameTaskScheduler;
+
+class MULTITASK2_API FMultiTask2Module : public IModuleInterface
 {
 public:
 
     /** IModuleInterface implementation */
     void StartupModule() override;
     void ShutdownModule() override;
+
+    static FMultiTask2Module& Get();
+
+    /** Find a Thread Pool registered in the project settings. Returns nullptr if there is no pool with that name. */
+    UMultiTaskThreadPool* FindThreadPool(FName Name) const;
+
+    /** Command Buffer shared by all Tasks, flushed every frame. Returns nullptr before the engine finished initializing. */
+    UMultiTaskCommandBuffer* GetCommandBuffer() const;
+
+    /** Scheduler serving all Multi-Frame Tasks. Returns nullptr before the engine finished initializing. */
+    UMultiFrameTaskScheduler* GetMultiFrameScheduler() const;
+
+private:
+    void CreateThreadPools();
+    void DestroyThreadPools();
+
+    TMap<FName, UMultiTaskThreadPool*> ThreadPools;
+    UMultiTaskCommandBuffer* CommandBuffer = nullptr;
+    UMultiFrameTaskScheduler* MultiFrameScheduler = nullptr;
+    FDelegateHandle PostEngineInitHandle;
 };
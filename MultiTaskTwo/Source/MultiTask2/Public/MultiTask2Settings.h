@@ -0,0 +1,64 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "MultiTaskThreadPool.h"
+#include "MultiTask2Settings.generated.h"
+
+USTRUCT(BlueprintType)
+struct MULTITASK2_API FMultiTaskThreadPoolSettings
+{
+	GENERATED_BODY()
+
+	/**
+	* Name used to look up the Thread Pool with Get Thread Pool By Name.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Thread Pool")
+		FName Name = NAME_None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Meta = (ClampMin = "1", UIMin = "1"), Category = "Thread Pool")
+		int32 NumQueuedThreads = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Meta = (ClampMin = "16384", UIMin = "16384"), Category = "Thread Pool")
+		int32 StackSize = 32768;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Thread Pool")
+		EMultiTaskThreadPriority ThreadPriority = EMultiTaskThreadPriority::Normal;
+
+	/**
+	* CPU affinity mask applied to every worker thread of the pool. 0 keeps the platform default.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Thread Pool")
+		int64 AffinityMask = 0;
+};
+
+/**
+* Multi Task 2 project settings.
+*/
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Multi Task 2"))
+class MULTITASK2_API UMultiTask2Settings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+public:
+	UMultiTask2Settings();
+
+	/**
+	* Thread Pools created at startup and shared through Get Thread Pool By Name.
+	* Creating them up front avoids thread creation hitches at first use.
+	*/
+	UPROPERTY(config, EditAnywhere, Category = "Thread Pools")
+		TArray<FMultiTaskThreadPoolSettings> ThreadPools;
+
+	/**
+	* Game Thread time in milliseconds the default Command Buffer spends executing commands per frame. 0 executes every pending command.
+	*/
+	UPROPERTY(config, EditAnywhere, Meta = (ClampMin = "0.0", UIMin = "0.0"), Category = "Command Buffer")
+		float CommandBufferFrameBudget = 1.0f;
+
+	/**
+	* Game Thread time in milliseconds shared by all running Multi-Frame Tasks per frame, served by priority.
+	* 0 (default) lets every Task run its own Iterations Per Tick or Time Budget. A budget can stop Tasks before their Iterations Per Tick.
+	*/
+	UPROPERTY(config, EditAnywhere, Meta = (ClampMin = "0.0", UIMin = "0.0"), Category = "Multi-Frame")
+		float MultiFrameFrameBudget = 0.0f;
+};
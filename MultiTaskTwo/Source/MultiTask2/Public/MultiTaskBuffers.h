@@ -0,0 +1,112 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "GenerateMarchingCubesTask.h"
+#include "MultiTaskBuffers.generated.h"
+
+/**
+* Immutable, reference counted array.
+* Copies share the same storage, so a buffer can be handed between Tasks, nodes and threads without copying its elements.
+*/
+template<typename ElementType>
+class TMultiTaskImmutableBuffer
+{
+public:
+	typedef TSharedPtr<const TArray<ElementType>, ESPMode::ThreadSafe> FStoragePtr;
+
+	TMultiTaskImmutableBuffer() = default;
+
+	/**
+	* Take ownership of the elements without copying them.
+	*/
+	explicit TMultiTaskImmutableBuffer(TArray<ElementType>&& Elements)
+		: Storage(MakeShared<const TArray<ElementType>, ESPMode::ThreadSafe>(MoveTemp(Elements)))
+	{}
+
+	const TArray<ElementType>& Get() const
+	{
+		static const TArray<ElementType> EmptyArray;
+		return Storage.IsValid() ? *Storage : EmptyArray;
+	}
+
+	const ElementType* GetData() const
+	{
+		return Storage.IsValid() ? Storage->GetData() : nullptr;
+	}
+
+	int32 Num() const
+	{
+		return Storage.IsValid() ? Storage->Num() : 0;
+	}
+
+	bool IsValidIndex(int32 Index) const
+	{
+		return Storage.IsValid() && Storage->IsValidIndex(Index);
+	}
+
+	/**
+	* Shared storage, keeps the elements alive for as long as it is referenced.
+	*/
+	const FStoragePtr& GetStorage() const
+	{
+		return Storage;
+	}
+
+	void Reset()
+	{
+		Storage.Reset();
+	}
+
+private:
+	FStoragePtr Storage;
+};
+
+/**
+* Handle to an immutable array of transforms.
+*/
+USTRUCT(BlueprintType)
+struct MULTITASK2_API FMultiTaskTransformBuffer
+{
+	GENERATED_BODY()
+	TMultiTaskImmutableBuffer<FTransform> Buffer;
+};
+
+/**
+* Handle to an immutable array of floats.
+*/
+USTRUCT(BlueprintType)
+struct MULTITASK2_API FMultiTaskFloatBuffer
+{
+	GENERATED_BODY()
+	TMultiTaskImmutableBuffer<float> Buffer;
+};
+
+/**
+* Handle to an immutable array of vectors.
+*/
+USTRUCT(BlueprintType)
+struct MULTITASK2_API FMultiTaskVectorBuffer
+{
+	GENERATED_BODY()
+	TMultiTaskImmutableBuffer<FVector> Buffer;
+};
+
+/**
+* Handle to an immutable array of bytes.
+*/
+USTRUCT(BlueprintType)
+struct MULTITASK2_API FMultiTaskByteBuffer
+{
+	GENERATED_BODY()
+	TMultiTaskImmutableBuffer<uint8> Buffer;
+};
+
+/**
+* Handle to immutable Renderable Geometry, one entry per LOD.
+*/
+USTRUCT(BlueprintType)
+struct MULTITASK2_API FMultiTaskMeshDataBuffer
+{
+	GENERATED_BODY()
+	TMultiTaskImmutableBuffer<FMarchingCubesMeshData> Buffer;
+};
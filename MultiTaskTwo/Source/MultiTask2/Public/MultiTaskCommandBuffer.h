@@ -0,0 +1,110 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Tickable.h"
+#include "Containers/Queue.h"
+#include "MultiTaskCommandBuffer.generated.h"
+
+class AActor;
+class UActorComponent;
+class USceneComponent;
+
+/**
+* Game Thread command buffer.
+* Any thread can append commands without locking, the buffer executes them in order once per frame on Game Thread,
+* so Task Bodies can touch UObjects without ending the Task or scheduling one Game Thread task per call.
+* Commands on objects destroyed in the meantime are skipped.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskCommandBuffer : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	/**
+	* Append a command executed on Game Thread during the next flush.
+	*/
+	void Enqueue(TUniqueFunction<void()>&& Command);
+
+	/**
+	* Append a command operating on Target. The command is skipped if Target is no longer valid when the buffer flushes.
+	*/
+	void Enqueue(UObject* Target, TUniqueFunction<void(UObject*)>&& Command);
+
+	/**
+	* Call a function without parameters on Target.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer")
+		void CallFunction(UObject* Target, FName FunctionName);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Property")
+		void SetBoolProperty(UObject* Target, FName PropertyName, bool Value);
+
+	/**
+	* Set an integer or byte property.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Property")
+		void SetIntegerProperty(UObject* Target, FName PropertyName, int64 Value);
+
+	/**
+	* Set a float or double property.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Property")
+		void SetFloatProperty(UObject* Target, FName PropertyName, double Value);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Property")
+		void SetVectorProperty(UObject* Target, FName PropertyName, FVector Value);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Property")
+		void SetStringProperty(UObject* Target, FName PropertyName, const FString& Value);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Component")
+		void SetActorTransform(AActor* Actor, FTransform Transform);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Component")
+		void SetComponentWorldTransform(USceneComponent* Component, FTransform Transform);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Component")
+		void SetComponentRelativeTransform(USceneComponent* Component, FTransform Transform);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Component")
+		void SetComponentVisibility(USceneComponent* Component, bool bNewVisibility, bool bPropagateToChildren = false);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Command Buffer|Component")
+		void DestroyComponent(UActorComponent* Component);
+
+	/**
+	* Amount of commands waiting for the next flush.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Command Buffer")
+		int32 GetPendingCommandsNum();
+
+	/**
+	* Execute pending commands right away, ignoring the frame budget. Game Thread only.
+	* @return Amount of executed commands.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Command Buffer")
+		int32 Flush();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual bool IsTickableInEditor() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	int32 Execute(double BudgetSeconds);
+
+public:
+	/**
+	* Game Thread time in milliseconds spent executing commands per frame. Commands over budget carry over to the next frame.
+	* 0 executes every pending command.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0.0", UIMin = "0.0"), Category = "Command Buffer")
+		float FrameBudget = 1.0f;
+
+private:
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Commands;
+	FThreadSafeCounter PendingCommands;
+};
@@ -0,0 +1,479 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Misc/ScopeRWLock.h"
+#include "HAL/PlatformProcess.h"
+#include <atomic>
+#include "MultiTaskConcurrentContainers.generated.h"
+
+/**
+* Hash map split in independently locked shards. Threads working on keys of different shards never contend.
+*/
+template<typename KeyType, typename ValueType, int32 NumShards = 16>
+class TMultiTaskShardedMap
+{
+public:
+	void Set(const KeyType& Key, const ValueType& Value)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock Lock(Shard.Lock);
+		Shard.Map.Add(Key, Value);
+	}
+
+	/**
+	* Add the value only if the key is not in the map yet.
+	* @return True if the value was added.
+	*/
+	bool TryAdd(const KeyType& Key, const ValueType& Value)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock Lock(Shard.Lock);
+		if (Shard.Map.Contains(Key))
+		{
+			return false;
+		}
+		Shard.Map.Add(Key, Value);
+		return true;
+	}
+
+	bool Find(const KeyType& Key, ValueType& OutValue) const
+	{
+		const FShard& Shard = GetShard(Key);
+		FReadScopeLock Lock(Shard.Lock);
+		if (const ValueType* Value = Shard.Map.Find(Key))
+		{
+			OutValue = *Value;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	* Read-modify-write the value of Key under the shard lock. Missing keys start from a default constructed value.
+	* @return The updated value.
+	*/
+	template<typename FunctorType>
+	ValueType Update(const KeyType& Key, FunctorType&& Functor)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock Lock(Shard.Lock);
+		ValueType& Value = Shard.Map.FindOrAdd(Key);
+		Functor(Value);
+		return Value;
+	}
+
+	bool Remove(const KeyType& Key)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock Lock(Shard.Lock);
+		return Shard.Map.Remove(Key) > 0;
+	}
+
+	int32 Num() const
+	{
+		int32 Count = 0;
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			Count += Shard.Map.Num();
+		}
+		return Count;
+	}
+
+	void Empty()
+	{
+		for (FShard& Shard : Shards)
+		{
+			FWriteScopeLock Lock(Shard.Lock);
+			Shard.Map.Empty();
+		}
+	}
+
+	/**
+	* Copy every pair into a regular map. Each shard is consistent, the whole copy is not a snapshot while writers are active.
+	*/
+	void CopyTo(TMap<KeyType, ValueType>& OutMap) const
+	{
+		OutMap.Reset();
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			OutMap.Append(Shard.Map);
+		}
+	}
+
+private:
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+		TMap<KeyType, ValueType> Map;
+	};
+
+	FShard& GetShard(const KeyType& Key)
+	{
+		return Shards[GetTypeHash(Key) % (uint32)NumShards];
+	}
+
+	const FShard& GetShard(const KeyType& Key) const
+	{
+		return Shards[GetTypeHash(Key) % (uint32)NumShards];
+	}
+
+	FShard Shards[NumShards];
+};
+
+/**
+* Set split in independently locked shards.
+*/
+template<typename KeyType, int32 NumShards = 16>
+class TMultiTaskShardedSet
+{
+public:
+	/**
+	* @return True if the key was not in the set yet.
+	*/
+	bool Add(const KeyType& Key)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock Lock(Shard.Lock);
+		bool bAlreadyInSet = false;
+		Shard.Set.Add(Key, &bAlreadyInSet);
+		return !bAlreadyInSet;
+	}
+
+	bool Contains(const KeyType& Key) const
+	{
+		const FShard& Shard = GetShard(Key);
+		FReadScopeLock Lock(Shard.Lock);
+		return Shard.Set.Contains(Key);
+	}
+
+	bool Remove(const KeyType& Key)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock Lock(Shard.Lock);
+		return Shard.Set.Remove(Key) > 0;
+	}
+
+	int32 Num() const
+	{
+		int32 Count = 0;
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			Count += Shard.Set.Num();
+		}
+		return Count;
+	}
+
+	void Empty()
+	{
+		for (FShard& Shard : Shards)
+		{
+			FWriteScopeLock Lock(Shard.Lock);
+			Shard.Set.Empty();
+		}
+	}
+
+	void CopyTo(TArray<KeyType>& OutArray) const
+	{
+		OutArray.Reset();
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			OutArray.Append(Shard.Set.Array());
+		}
+	}
+
+private:
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+		TSet<KeyType> Set;
+	};
+
+	FShard& GetShard(const KeyType& Key)
+	{
+		return Shards[GetTypeHash(Key) % (uint32)NumShards];
+	}
+
+	const FShard& GetShard(const KeyType& Key) const
+	{
+		return Shards[GetTypeHash(Key) % (uint32)NumShards];
+	}
+
+	FShard Shards[NumShards];
+};
+
+/**
+* Append only array with stable element addresses.
+* Storage grows in chunks of doubling size that are never moved. Slots are claimed without locking,
+* but elements are published in index order once written: an Add waits for the earlier Adds to publish theirs,
+* so a preempted adder stalls the ones after it. In exchange every index below Num() is readable from any thread.
+*/
+template<typename ElementType>
+class TMultiTaskConcurrentArray
+{
+public:
+	TMultiTaskConcurrentArray() = default;
+	TMultiTaskConcurrentArray(const TMultiTaskConcurrentArray&) = delete;
+	TMultiTaskConcurrentArray& operator=(const TMultiTaskConcurrentArray&) = delete;
+
+	~TMultiTaskConcurrentArray()
+	{
+		Empty();
+	}
+
+	/**
+	* @return Stable index of the added element.
+	*/
+	int32 Add(const ElementType& Element)
+	{
+		const int32 Index = Reserved.fetch_add(1);
+		int32 Offset = 0;
+		ElementType* Chunk = GetOrAllocateChunk(GetChunkIndex(Index, Offset));
+		Chunk[Offset] = Element;
+
+		// Wait for the earlier Adds to publish theirs, they only have a copy left to do.
+		int32 Expected = Index;
+		while (!Count.compare_exchange_weak(Expected, Index + 1))
+		{
+			Expected = Index;
+			FPlatformProcess::Yield();
+		}
+		return Index;
+	}
+
+	bool IsValidIndex(int32 Index) const
+	{
+		return Index >= 0 && Index < Num();
+	}
+
+	const ElementType& operator[](int32 Index) const
+	{
+		check(IsValidIndex(Index));
+		int32 Offset = 0;
+		const int32 ChunkIndex = GetChunkIndex(Index, Offset);
+		return Chunks[ChunkIndex].load()[Offset];
+	}
+
+	ElementType& operator[](int32 Index)
+	{
+		check(IsValidIndex(Index));
+		int32 Offset = 0;
+		const int32 ChunkIndex = GetChunkIndex(Index, Offset);
+		return Chunks[ChunkIndex].load()[Offset];
+	}
+
+	int32 Num() const
+	{
+		return FMath::Min(Count.load(), MaxElements);
+	}
+
+	/**
+	* Release all chunks. Not thread safe, no other thread may access the array meanwhile.
+	*/
+	void Empty()
+	{
+		for (std::atomic<ElementType*>& Chunk : Chunks)
+		{
+			delete[] Chunk.exchange(nullptr);
+		}
+		Reserved = 0;
+		Count = 0;
+	}
+
+	void CopyTo(TArray<ElementType>& OutArray) const
+	{
+		const int32 Total = Num();
+		OutArray.Reset(Total);
+		for (int32 Index = 0; Index < Total; ++Index)
+		{
+			OutArray.Add((*this)[Index]);
+		}
+	}
+
+private:
+	static constexpr int32 FirstChunkSize = 64;
+	static constexpr int32 NumChunks = 25;
+	static constexpr int32 MaxElements = FirstChunkSize * ((1 << NumChunks) - 1);
+
+	// Chunk N holds FirstChunkSize << N elements, starting at index FirstChunkSize * (2^N - 1).
+	static int32 GetChunkIndex(int32 Index, int32& OutOffset)
+	{
+		checkf(Index >= 0 && Index < MaxElements, TEXT("Concurrent array is full."));
+		const int32 ChunkIndex = (int32)FMath::FloorLog2((uint32)(Index / FirstChunkSize + 1));
+		OutOffset = Index - FirstChunkSize * ((1 << ChunkIndex) - 1);
+		return ChunkIndex;
+	}
+
+	ElementType* GetOrAllocateChunk(int32 ChunkIndex)
+	{
+		ElementType* Chunk = Chunks[ChunkIndex].load();
+		if (Chunk)
+		{
+			return Chunk;
+		}
+
+		// Racing threads allocate, the loser frees its chunk and uses the winner's.
+		ElementType* NewChunk = new ElementType[FirstChunkSize << ChunkIndex];
+		if (Chunks[ChunkIndex].compare_exchange_strong(Chunk, NewChunk))
+		{
+			return NewChunk;
+		}
+		delete[] NewChunk;
+		return Chunk;
+	}
+
+	std::atomic<ElementType*> Chunks[NumChunks] = {};
+	// Indices handed out by Add, and the readable prefix of them.
+	std::atomic<int32> Reserved{ 0 };
+	std::atomic<int32> Count{ 0 };
+};
+
+/**
+* Concurrent map for sharing results between parallel Tasks without a global lock.
+* Keys are integers, names or vectors (compared exactly), values are integers, e.g. indices into a Concurrent Array.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskConcurrentMap : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Integer")
+		void SetByInteger(int64 Key, int32 Value);
+	/**
+	* Add the value only if the key is not in the map yet.
+	* @return True if this call added the value.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Integer")
+		bool TryAddByInteger(int64 Key, int32 Value);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Integer")
+		bool FindByInteger(int64 Key, int32& Value);
+	/**
+	* Atomically add Amount to the value of Key. Missing keys start from 0.
+	* @return The updated value.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Integer")
+		int32 IncrementByInteger(int64 Key, int32 Amount = 1);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Integer")
+		bool RemoveByInteger(int64 Key);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Name")
+		void SetByName(FName Key, int32 Value);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Name")
+		bool TryAddByName(FName Key, int32 Value);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Name")
+		bool FindByName(FName Key, int32& Value);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Name")
+		int32 IncrementByName(FName Key, int32 Amount = 1);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Name")
+		bool RemoveByName(FName Key);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Vector")
+		void SetByVector(FVector Key, int32 Value);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Vector")
+		bool TryAddByVector(FVector Key, int32 Value);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Vector")
+		bool FindByVector(FVector Key, int32& Value);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Vector")
+		int32 IncrementByVector(FVector Key, int32 Amount = 1);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map|Vector")
+		bool RemoveByVector(FVector Key);
+
+	/**
+	* Amount of pairs over all key types.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Concurrent Map")
+		int32 Num();
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Map")
+		void Empty();
+
+private:
+	TMultiTaskShardedMap<int64, int32> IntegerMap;
+	TMultiTaskShardedMap<FName, int32> NameMap;
+	TMultiTaskShardedMap<FVector, int32> VectorMap;
+};
+
+/**
+* Concurrent set of integers, names or vectors (compared exactly). Useful to claim work exactly once across parallel Tasks.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskConcurrentSet : public UObject
+{
+	GENERATED_BODY()
+public:
+	/**
+	* @return True if the key was not in the set yet.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Integer")
+		bool AddInteger(int64 Key);
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Integer")
+		bool ContainsInteger(int64 Key);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Integer")
+		bool RemoveInteger(int64 Key);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Name")
+		bool AddName(FName Key);
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Name")
+		bool ContainsName(FName Key);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Name")
+		bool RemoveName(FName Key);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Vector")
+		bool AddVector(FVector Key);
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Vector")
+		bool ContainsVector(FVector Key);
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Set|Vector")
+		bool RemoveVector(FVector Key);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Concurrent Set")
+		int32 Num();
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Set")
+		void Empty();
+
+private:
+	TMultiTaskShardedSet<int64> IntegerSet;
+	TMultiTaskShardedSet<FName> NameSet;
+	TMultiTaskShardedSet<FVector> VectorSet;
+};
+
+/**
+* Append only array of vectors with stable indices. Adds publish in index order, an Add may briefly wait for earlier ones to finish.
+* Read elements once the Tasks adding them finished.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskConcurrentArray : public UObject
+{
+	GENERATED_BODY()
+public:
+	/**
+	* @return Stable index of the added element.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Array")
+		int32 Add(FVector Element);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Concurrent Array")
+		FVector Get(int32 Index);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Concurrent Array")
+		int32 Num();
+
+	/**
+	* Copy the elements to a regular array, in index order.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Concurrent Array")
+		TArray<FVector> ToArray();
+
+	/**
+	* Release all elements. Must not be called while other Tasks access the array.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Concurrent Array")
+		void Empty();
+
+private:
+	TMultiTaskConcurrentArray<FVector> Elements;
+};
@@ -0,0 +1,47 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
+
+/**
+* Learned execution times per Task class and input size.
+* Sizes are grouped in power of two buckets, each bucket keeps an exponential moving average of the measured times.
+*/
+class MULTITASK2_API FMultiTaskCostModel
+{
+public:
+	static FMultiTaskCostModel& Get();
+
+	/**
+	* Record one execution.
+	* @param TaskClass		Name of the Task class.
+	* @param WorkSize		Input size of the executed work.
+	* @param Milliseconds	Measured execution time.
+	*/
+	void Record(FName TaskClass, int32 WorkSize, double Milliseconds);
+
+	/**
+	* Expected execution time in milliseconds. Sizes without samples are extrapolated linearly from the nearest recorded bucket.
+	* @return Expected time or a negative value if the class has no samples yet.
+	*/
+	double Estimate(FName TaskClass, int32 WorkSize) const;
+
+	/**
+	* Amount of recorded executions for the class and size bucket.
+	*/
+	int32 GetSampleCount(FName TaskClass, int32 WorkSize) const;
+
+	void Reset();
+
+private:
+	struct FCostEntry
+	{
+		double AverageMilliseconds = 0.0;
+		int32 Samples = 0;
+	};
+
+	static int32 GetSizeBucket(int32 WorkSize);
+
+	mutable FCriticalSection Section;
+	TMap<FName, TMap<int32, FCostEntry>> Entries;
+};
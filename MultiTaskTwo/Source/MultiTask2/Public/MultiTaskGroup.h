@@ -0,0 +1,94 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/CriticalSection.h"
+#include "MultiTaskGroup.generated.h"
+
+class UMultiTaskBase;
+class FEvent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FMultiTaskGroupDelegate);
+
+/**
+* Tracks the work of any number of Tasks with one outstanding work counter.
+* Tasks join the group before they start (e.g. from the On Start branch) and the whole group can be waited for or canceled at once.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskGroup : public UObject
+{
+	GENERATED_BODY()
+public:
+	UMultiTaskGroup();
+
+	/**
+	* Add a Task to the group. The Task's work is tracked from its next Start.
+	* @param Task	Task to be added.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Task Group")
+		void AddTask(UMultiTaskBase* Task);
+
+	/**
+	* Block the calling thread until all the work in the group finished.
+	* Do not call this on Game Thread while the group contains Multi-Frame Tasks, they progress on Game Thread.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Task Group")
+		void WaitAll();
+
+	/**
+	* Check whether all the work in the group finished.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Task Group")
+		bool IsDone();
+
+	/**
+	* Cancel every Task in the group. All Tasks observe the cancellation through one shared flag.
+	* The cancellation also applies to Tasks started later, until Reset Group is called.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Task Group")
+		void CancelAll();
+
+	/**
+	* Check whether the group has been canceled.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Task Group")
+		bool IsCanceled();
+
+	/**
+	* Clear a previous Cancel All so the group can track new work.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Task Group")
+		void ResetGroup();
+
+	/**
+	* Amount of work items still running or queued.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Task Group")
+		int32 GetOutstandingWorkNum();
+
+	void OnWorkStarted();
+	void OnWorkFinished();
+
+	virtual void BeginDestroy() override;
+
+public:
+	/**
+	* Called on Game Thread when the outstanding work reaches zero and the group was not canceled.
+	*/
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+		FMultiTaskGroupDelegate OnCompleted;
+
+	/**
+	* Called on Game Thread when the group is canceled.
+	*/
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+		FMultiTaskGroupDelegate OnCanceled;
+
+private:
+	FThreadSafeCounter OutstandingWork;
+	FThreadSafeBool bCanceled = false;
+	FEvent* DoneEvent = nullptr;
+	FCriticalSection DoneSection;
+};
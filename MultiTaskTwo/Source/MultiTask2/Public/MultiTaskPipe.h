@@ -0,0 +1,62 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MultiTaskPipe.generated.h"
+
+/**
+* Serial execution queue.
+* Work pushed to the same pipe runs one at a time in push order. Queued work is only handed to a worker once the previous work finished,
+* so no worker thread is ever blocked waiting for its turn.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskPipe : public UObject
+{
+	GENERATED_BODY()
+public:
+	/** Launches one piece of work, which must call the provided function once it finished. */
+	typedef TUniqueFunction<void(TUniqueFunction<void()>&&)> FPipeStep;
+
+	/**
+	* Queue a step behind the work already in the pipe.
+	* @param OnDiscarded	Called instead of Step when the step is dropped before its turn.
+	* @param Owner			Launcher identity used by Drop Queued Work.
+	*/
+	void Push(FPipeStep&& Step, TUniqueFunction<void()>&& OnDiscarded = nullptr, const void* Owner = nullptr);
+
+	/**
+	* Remove the queued steps of the specified owner without running them. The step in flight is not affected.
+	* @return Amount of dropped steps.
+	*/
+	int32 DropQueuedWork(const void* Owner);
+
+	virtual void BeginDestroy() override;
+
+	/**
+	* Check whether the pipe is executing or has queued work.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Pipe")
+		bool IsBusy();
+
+	/**
+	* Amount of work waiting for its turn, not counting the work in flight.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Pipe")
+		int32 GetQueuedWorkNum();
+
+private:
+	void RunNext();
+
+	struct FQueuedStep
+	{
+		FPipeStep Step;
+		TUniqueFunction<void()> OnDiscarded;
+		const void* Owner = nullptr;
+	};
+
+	static void DiscardStep(FQueuedStep& QueuedStep);
+
+	FCriticalSection Section;
+	TArray<FQueuedStep> QueuedSteps;
+	bool bInFlight = false;
+};
@@ -0,0 +1,145 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include <atomic>
+#include "MultiTaskResultBuffers.generated.h"
+
+/**
+* Lock free triple buffer for one writer and one reader thread.
+* The writer fills its slot and publishes it, the reader acquires the latest published slot. Neither side ever waits for the other
+* and no data is copied, slots are only exchanged. Frames published faster than the reader acquires them are skipped.
+*/
+template<typename ValueType>
+class TMultiTaskTripleBuffer
+{
+public:
+	/**
+	* Slot owned by the writer. Only the writer thread may access it.
+	*/
+	ValueType& GetWriteBuffer()
+	{
+		return Slots[WriteIndex];
+	}
+
+	/**
+	* Make the write slot the latest result and take over a free slot for the next write.
+	*/
+	void Publish()
+	{
+		const uint8 Previous = State.exchange(WriteIndex | DirtyFlag, std::memory_order_acq_rel);
+		WriteIndex = Previous & IndexMask;
+	}
+
+	/**
+	* Take over the latest published slot, if there is one newer than the current read slot.
+	* @return True if the read slot changed.
+	*/
+	bool Acquire()
+	{
+		if ((State.load(std::memory_order_acquire) & DirtyFlag) == 0)
+		{
+			return false;
+		}
+		const uint8 Previous = State.exchange(ReadIndex, std::memory_order_acq_rel);
+		ReadIndex = Previous & IndexMask;
+		return true;
+	}
+
+	/**
+	* Slot owned by the reader, it holds the latest acquired result. Only the reader thread may access it.
+	*/
+	ValueType& GetReadBuffer()
+	{
+		return Slots[ReadIndex];
+	}
+
+	/**
+	* Check whether a result was published since the last Acquire. Safe from any thread.
+	*/
+	bool HasNewData() const
+	{
+		return (State.load(std::memory_order_acquire) & DirtyFlag) != 0;
+	}
+
+private:
+	static constexpr uint8 IndexMask = 0x3;
+	static constexpr uint8 DirtyFlag = 0x4;
+
+	ValueType Slots[3];
+	uint8 WriteIndex = 0;
+	uint8 ReadIndex = 1;
+	// Index of the slot between writer and reader, plus whether it holds unread data.
+	std::atomic<uint8> State{ 2 };
+};
+
+/**
+* Per frame results of Transforms exchanged between one worker and Game Thread.
+* The worker writes frame N+1 while Game Thread reads frame N, without locks or copies.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskTransformResultBuffer : public UObject
+{
+	GENERATED_BODY()
+public:
+	/**
+	* Publish Data as the latest result. Data is exchanged with a free slot, afterwards it holds an older result to overwrite.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		void Publish(UPARAM(ref) TArray<FTransform>& Data);
+
+	/**
+	* Exchange Data with the latest published result.
+	* @return True if a new result was acquired. Data is left untouched otherwise.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		bool Acquire(UPARAM(ref) TArray<FTransform>& Data);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		bool HasNewData();
+
+private:
+	TMultiTaskTripleBuffer<TArray<FTransform>> Buffer;
+};
+
+/**
+* Per frame results of Floats exchanged between one worker and Game Thread, e.g. influence maps.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskFloatResultBuffer : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		void Publish(UPARAM(ref) TArray<float>& Data);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		bool Acquire(UPARAM(ref) TArray<float>& Data);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		bool HasNewData();
+
+private:
+	TMultiTaskTripleBuffer<TArray<float>> Buffer;
+};
+
+/**
+* Per frame results of Vectors exchanged between one worker and Game Thread.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskVectorResultBuffer : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		void Publish(UPARAM(ref) TArray<FVector>& Data);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		bool Acquire(UPARAM(ref) TArray<FVector>& Data);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Result Buffer")
+		bool HasNewData();
+
+private:
+	TMultiTaskTripleBuffer<TArray<FVector>> Buffer;
+};
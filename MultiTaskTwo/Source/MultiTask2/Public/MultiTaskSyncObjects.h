@@ -0,0 +1,114 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MultiTaskSyncObjects.generated.h"
+
+class FEvent;
+
+/**
+* Reusable barrier for a fixed amount of participants.
+* Every participant blocks in Arrive And Wait until all of them arrived, then the barrier resets for the next phase.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskBarrier : public UObject
+{
+	GENERATED_BODY()
+public:
+	void Init(int32 InParticipants);
+
+	/**
+	* Block the calling thread until all participants arrived.
+	* @return True for exactly one participant per phase (the last one to arrive).
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Barrier")
+		bool ArriveAndWait();
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Barrier")
+		int32 GetParticipants();
+
+	virtual void BeginDestroy() override;
+
+private:
+	FCriticalSection Section;
+	TArray<FEvent*> Waiters;
+	int32 Participants = 1;
+	int32 Arrived = 0;
+};
+
+/**
+* Single use count down latch.
+* Wait blocks until Count Down was called the initial amount of times.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskLatch : public UObject
+{
+	GENERATED_BODY()
+public:
+	void Init(int32 InCount);
+
+	/**
+	* Decrement the counter, releasing all waiting threads once it reaches zero.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Latch")
+		void CountDown(int32 Amount = 1);
+
+	/**
+	* Block the calling thread until the counter reaches zero.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Latch")
+		void Wait();
+
+	/**
+	* Check whether the counter reached zero without blocking.
+	*/
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Latch")
+		bool IsReleased();
+
+	virtual void BeginDestroy() override;
+
+private:
+	FCriticalSection Section;
+	TArray<FEvent*> Waiters;
+	int32 Count = 0;
+};
+
+/**
+* Counting semaphore.
+* Released permits are handed directly to the longest waiting thread.
+*/
+UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
+class MULTITASK2_API UMultiTaskSemaphore : public UObject
+{
+	GENERATED_BODY()
+public:
+	void Init(int32 InitialCount);
+
+	/**
+	* Take a permit, blocking the calling thread until one is available.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Semaphore")
+		void Acquire();
+
+	/**
+	* Take a permit only if one is available right away.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Semaphore")
+		bool TryAcquire();
+
+	/**
+	* Return permits, waking up to Count waiting threads.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe), Category = "Semaphore")
+		void Release(int32 Count = 1);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe), Category = "Semaphore")
+		int32 GetAvailableCount();
+
+	virtual void BeginDestroy() override;
+
+private:
+	FCriticalSection Section;
+	TArray<FEvent*> Waiters;
+	int32 Available = 0;
+};
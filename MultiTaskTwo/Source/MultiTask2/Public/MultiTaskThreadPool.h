@@ -4,6 +4,11 @@
 #include "Misc/QueuedThreadPool.h"
 #include "UObject/Object.h"
 #include "Templates/SharedPointer.h"
+#include "Async/Future.h"
+#include "Misc/Optional.h"
+#include "Tickable.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeBool.h"
 
 #ifndef ENGINE_MINOR_VERSION
 #include "Runtime/Launch/Resources/Version.h"
@@ -23,19 +28,296 @@ enum class EMultiTaskThreadPriority : uint8
 	TimeCritical,
 };
 
+UENUM(BlueprintType)
+enum class EMultiTaskWorkPriority : uint8
+{
+	Highest,
+	High,
+	Normal,
+	Low,
+	Lowest,
+};
+
+UENUM(BlueprintType)
+enum class EMultiTaskQueuePolicy : uint8
+{
+	/** The launching thread waits until the queue has room. Launches from the Game Thread are rejected instead. */
+	Block,
+	/** New work is rejected, the Task goes down its canceled branch. */
+	Reject,
+	/** New work replaces the oldest queued work with the same Coalesce Key, otherwise it is rejected. */
+	ReplaceOldest,
+};
+
+struct FMultiTaskPoolJob
+{
+	TUniqueFunction<void()> Body;
+	TPromise<void> Promise;
+	/** Expected execution time in milliseconds, negative if unknown. */
+	double ExpectedCost = -1.0;
+	/** Called instead of Body when the work is rejected, replaced or dropped from the queue. */
+	TUniqueFunction<void()> OnDiscarded;
+	FName CoalesceKey = NAME_None;
+	/** Work launched by the same owner never replaces each other. */
+	const void* Owner = nullptr;
+};
 
 UCLASS(BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
-class MULTITASK2_API UMultiTaskThreadPool : public UObject
+class MULTITASK2_API UMultiTaskThreadPool : public UObject, public FTickableGameObject
 {
+	friend class FMultiTaskPoolWork;
 	GENERATED_BODY()
 public:
 
 
 	bool Create(uint32 InNumQueuedThreads, uint32 StackSize = (32 * 1024), EThreadPriority ThreadPriority = TPri_Normal, const FString Name = "UnknownThreadPool");
 
+	/**
+	* Pin every worker thread of the pool to the specified CPU affinity mask.
+	* Blocks until each worker thread picked up its affinity work item, which also guarantees the threads are up and running.
+	* @param AffinityMask	CPU affinity mask. 0 is ignored.
+	*/
+	void SetThreadsAffinity(uint64 AffinityMask);
+
+	static EThreadPriority ToThreadPriority(EMultiTaskThreadPriority ThreadPriority);
+
+	/**
+	* Queue work on the Thread Pool.
+	* Work waits in the pool's own priority queue and is handed to the worker threads only while the active threads limit allows it.
+	* @param Body			Work to be executed on a pool thread.
+	* @param OnCompleted	Called on the pool thread after Body finished.
+	* @param Priority		Work priority. Higher priority work is dispatched first.
+	* @param ExpectedCost	Expected execution time in milliseconds, used to order batches longest-expected-first.
+	* @param CoalesceKey	Key used by the Replace Oldest queue policy.
+	* @param Owner			Launcher identity. Work of the same owner never replaces each other.
+	* @param OnDiscarded	Called when the work is rejected, replaced or dropped from the queue without being executed.
+	* @return Future that completes once the work executed (or got discarded).
+	*/
+	TFuture<void> Launch(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted = nullptr, EMultiTaskWorkPriority Priority = EMultiTaskWorkPriority::Normal, double ExpectedCost = -1.0,
+		FName CoalesceKey = NAME_None, const void* Owner = nullptr, TUniqueFunction<void()>&& OnDiscarded = nullptr);
+
+	/**
+	* Queue work on the Thread Pool without ever waiting for room. The Block queue policy rejects it on a full queue, as for the Game Thread.
+	* Safe to call from the pool's own worker threads.
+	* @return Future that completes once the work executed (or got discarded).
+	*/
+	TFuture<void> TryLaunch(TUniqueFunction<void()>&& Body, EMultiTaskWorkPriority Priority = EMultiTaskWorkPriority::Normal, TUniqueFunction<void()>&& OnDiscarded = nullptr);
+
+	/**
+	* Hold dispatching of launched work until the matching End Batch.
+	* The work launched in between is then ordered longest-expected-first within each priority, which shortens the batch makespan.
+	* Batches can be nested. Every Begin Batch must be matched, the work launched inside an open batch is held
+	* and the Block queue policy does not wait for room, so keep batches short and scoped. Prefer FMultiTaskPoolBatchScope.
+	*/
+	void BeginBatch();
+
+	/**
+	* Order the work launched since Begin Batch longest-expected-first and dispatch it.
+	*/
+	void EndBatch();
+
 	UFUNCTION(BlueprintPure, Category = "Thread Pool")
 		int32 GetThreadsNum();
 
+	/**
+	* Amount of work items waiting in the queue to be dispatched to a worker thread.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Thread Pool")
+		int32 GetQueuedWorkNum();
+
+	/**
+	* Amount of work items of the specified priority waiting in the queue.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Thread Pool|Queue")
+		int32 GetQueuedWorkNumForPriority(EMultiTaskWorkPriority Priority);
+
+	/**
+	* Highest queue length observed since the metrics were reset.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Thread Pool|Queue")
+		int32 GetPeakQueuedWorkNum();
+
+	/**
+	* Amount of work items rejected because the queue was full.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Thread Pool|Queue")
+		int32 GetRejectedWorkNum();
+
+	/**
+	* Amount of queued work items replaced by newer work with the same Coalesce Key.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Thread Pool|Queue")
+		int32 GetReplacedWorkNum();
+
+	UFUNCTION(BlueprintCallable, Category = "Thread Pool|Queue")
+		void ResetQueueMetrics();
+
+	/**
+	* Remove all queued work launched by the specified owner without executing it.
+	* Work already handed to a worker thread is not affected.
+	* @return Amount of dropped work items.
+	*/
+	int32 DropQueuedWork(const void* Owner);
+
+	/**
+	* Check whether work with a higher priority than the specified one is waiting in the queue.
+	* Lock free, cheap enough to be called from inner loops.
+	*/
+	bool HasWaitingWork(EMultiTaskWorkPriority Priority) const;
+
+	/**
+	* Execute queued work with a higher priority than the specified one on the calling thread.
+	* Intended to be called from a worker thread of this pool at a cooperative yield point.
+	* @return True if any work was executed.
+	*/
+	bool RunWaitingWork(EMultiTaskWorkPriority Priority);
+
+	/**
+	* Watch Game and Render Thread frame times and reduce the amount of active worker threads when the frame exceeds the target.
+	* Throughput is restored gradually once there is headroom again.
+	* @param TargetFrameTimeMs		Frame time budget in milliseconds.
+	* @param MinThreads			The governor never goes below this amount of active threads.
+	* @param bPauseLowPriority	Hold Low and Lowest priority work in the queue while the pool is throttled.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Thread Pool|Governor")
+		void EnableFrameGovernor(float TargetFrameTimeMs = 16.6f, int32 MinThreads = 1, bool bPauseLowPriority = true);
+
+	/**
+	* Disable the frame governor and restore all worker threads.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Thread Pool|Governor")
+		void DisableFrameGovernor();
+
+	/**
+	* Current amount of worker threads allowed to execute work.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Thread Pool|Governor")
+		int32 GetActiveThreadsLimit();
+
+	/**
+	* Whether the frame governor currently limits the pool.
+	*/
+	UFUNCTION(BlueprintPure, Category = "Thread Pool|Governor")
+		bool IsThrottled();
+
+	virtual void BeginDestroy() override;
+
+	void OnWorkFinished();
+	void OnWorkAbandoned();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	TFuture<void> Enqueue(FMultiTaskPoolJob&& Job, EMultiTaskWorkPriority Priority, bool bAllowWait);
+	void Dispatch();
+	void AbandonQueuedWork();
+	void OnEndFrame();
+	int32 GetQueuedWorkNum_Locked() const;
+	bool RemoveOldestWithKey_Locked(FName CoalesceKey, const void* Owner, TOptional<FMultiTaskPoolJob>& OutJob);
+	/**
+	* Finish work that will never execute. On Discarded runs first, so the launching Task is already canceled when the completion is signaled.
+	*/
+	static void DiscardJob(FMultiTaskPoolJob& Job);
+
 public:
 	TSharedPtr <FQueuedThreadPool> Obj;
-};
\ No newline at end of file
+
+	/**
+	* Frame time budget in milliseconds used by the governor.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "1.0", UIMin = "1.0"), Category = "Governor")
+		float TargetFrameTime = 16.6f;
+
+	/**
+	* Fraction of the target frame time under which the governor considers that there is headroom.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0.1", ClampMax = "1.0", UIMin = "0.1", UIMax = "1.0"), Category = "Governor")
+		float HeadroomRatio = 0.85f;
+
+	/**
+	* Amount of consecutive frames with headroom required before a worker thread is restored.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "1", UIMin = "1"), Category = "Governor")
+		int32 RecoveryFrames = 10;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0", UIMin = "0"), Category = "Governor")
+		int32 MinActiveThreads = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Governor")
+		bool bPauseLowPriorityWork = true;
+
+	/**
+	* Maximum amount of work items waiting in the queue. 0 means unbounded.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0", UIMin = "0"), Category = "Queue")
+		int32 MaxQueuedWork = 0;
+
+	/**
+	* What happens to new work when the queue is full.
+	* Block should not be used from Tasks running on this pool, they would wait for their own worker threads. The Game Thread never blocks, it gets Reject.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Queue")
+		EMultiTaskQueuePolicy QueuePolicy = EMultiTaskQueuePolicy::Block;
+
+	/**
+	* Collect the work launched from the Game Thread during a frame into one batch, dispatched longest-expected-first at the end of the frame.
+	* Tasks of different kinds started by separate nodes are then ordered by their learned cost, at the price of up to one frame of latency.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Queue")
+		bool bBatchGameThreadWork = false;
+
+private:
+	FCriticalSection QueueSection;
+	static constexpr int32 NumWorkPriorities = 5;
+	TArray<FMultiTaskPoolJob> QueuedWork[NumWorkPriorities];
+	FThreadSafeCounter QueuedWorkCount[NumWorkPriorities];
+	FEvent* QueueSpaceEvent = nullptr;
+	int32 PeakQueuedWork = 0;
+	FThreadSafeCounter RejectedWork;
+	FThreadSafeCounter ReplacedWork;
+	int32 BatchDepth = 0;
+	int32 BatchStart[NumWorkPriorities];
+	/** Game Thread only. */
+	bool bFrameBatchOpen = false;
+	FDelegateHandle EndFrameHandle;
+	FThreadSafeCounter ActiveWork;
+	FThreadSafeCounter ActiveThreadsLimit;
+
+	bool bGovernorEnabled = false;
+	FThreadSafeBool bThrottled = false;
+	int32 HeadroomFrameCount = 0;
+};
+
+/**
+* Begin Batch for the lifetime of the scope, End Batch when it is left. A null Thread Pool does nothing.
+*/
+class FMultiTaskPoolBatchScope
+{
+public:
+	explicit FMultiTaskPoolBatchScope(UMultiTaskThreadPool* InThreadPool)
+		: ThreadPool(InThreadPool)
+	{
+		if (ThreadPool)
+		{
+			ThreadPool->BeginBatch();
+		}
+	}
+
+	~FMultiTaskPoolBatchScope()
+	{
+		if (ThreadPool)
+		{
+			ThreadPool->EndBatch();
+		}
+	}
+
+	FMultiTaskPoolBatchScope(const FMultiTaskPoolBatchScope&) = delete;
+	FMultiTaskPoolBatchScope& operator=(const FMultiTaskPoolBatchScope&) = delete;
+
+private:
+	UMultiTaskThreadPool* ThreadPool;
+};
@@ -53,6 +53,7 @@ public:
 	* Called on Background Thread when the Task is executed.
 	*/
 	virtual void TaskBody_Implementation() override;
+	virtual int32 GetWorkSize() const override;
 
 private:
 
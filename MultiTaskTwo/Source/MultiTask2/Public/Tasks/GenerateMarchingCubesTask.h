@@ -246,6 +246,7 @@ public:
 	virtual void TaskBody_Implementation() override;
 
 	virtual void Cancel() override;
+	virtual int32 GetWorkSize() const override;
 
 	void GenerateVoxelData();
 
@@ -331,6 +332,8 @@ private:
 
 };
 
+struct FMultiTaskMeshDataBuffer;
+
 class MULTITASK2_API FGenerateMarchingCubesTaskAction : public FSingleTaskActionBase
 {
 	EMultiTask2Branches& Branches;
@@ -421,13 +424,21 @@ public:
 class MULTITASK2_API FVoxelDataToMeshDataTaskAction : public FSingleTaskActionBase
 {
 	EMultiTask2Branches& Branches;
-	TArray<FMarchingCubesMeshData>& MeshData;
+	TArray<FMarchingCubesMeshData>* MeshData;
+	FMultiTaskMeshDataBuffer* MeshBuffer;
 	bool bStarted;
+
+	/** Hand the generated Mesh Data to the output without copying it. */
+	void MoveMeshDataToOutput(UGenerateMarchingCubesTask* LocalTask);
 public:
-	FVoxelDataToMeshDataTaskAction(UObject* InObject, EMultiTask2Branches& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UGenerateMarchingCubesTask> Class, const FIntVector& ChunkSlot, const FMarchingCubesSettings& Settings, const EMarchingCubesNormal& NormalType, const bool& bUseFlatShading, const FMarchingCubesData& InVoxelData, const TArray<FMarchingCubesSimplifierSettings>& SimplifierSettings, TArray<FMarchingCubesMeshData>& InMeshData, const ETaskExecutionType& InExecutionType, UMultiTaskThreadPool* ThreadPool, UGenerateMarchingCubesTask*& OutTask)
+	/**
+	* Exactly one of InMeshData and InMeshBuffer receives the generated Mesh Data.
+	*/
+	FVoxelDataToMeshDataTaskAction(UObject* InObject, EMultiTask2Branches& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UGenerateMarchingCubesTask> Class, const FIntVector& ChunkSlot, const FMarchingCubesSettings& Settings, const EMarchingCubesNormal& NormalType, const bool& bUseFlatShading, const FMarchingCubesData& InVoxelData, const TArray<FMarchingCubesSimplifierSettings>& SimplifierSettings, TArray<FMarchingCubesMeshData>* InMeshData, FMultiTaskMeshDataBuffer* InMeshBuffer, const ETaskExecutionType& InExecutionType, UMultiTaskThreadPool* ThreadPool, UGenerateMarchingCubesTask*& OutTask)
 		: FSingleTaskActionBase(InObject, LatentInfo, Class)
 		, Branches(InBranches)
 		, MeshData(InMeshData)
+		, MeshBuffer(InMeshBuffer)
 		, bStarted(false)
 	{
 
@@ -469,8 +480,7 @@ public:
 					UGenerateMarchingCubesTask* LocalTask = Cast<UGenerateMarchingCubesTask>(Task);
 					if (LocalTask)
 					{
-						MeshData = LocalTask->MeshData;
-						LocalTask->MeshData.Empty();
+						MoveMeshDataToOutput(LocalTask);
 						LocalTask->DensityData.Empty();
 						LocalTask->PointMap.Empty();
 						LocalTask->MCPointMap.Empty();
@@ -1,12 +1,12 @@
 // Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
 #pragma once
-#include "MultiTaskBase.h"
+#include "MultiFrameTaskBase.h"
 #include "MultiFrameAsyncTask.generated.h"
 
 DECLARE_MULTICAST_DELEGATE(FAsyncTaskDelegate);
 
 UCLASS(Blueprintable, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "True"))
-class MULTITASK2_API UMultiFrameAsyncTask : public UMultiTaskBase
+class MULTITASK2_API UMultiFrameAsyncTask : public UMultiFrameTaskBase
 {
 	GENERATED_BODY()
 
@@ -29,17 +29,10 @@ public:
 	virtual bool IsRunning() override;
 
 public:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
-		int32 IterationsPerTick = 1;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "0.0", UIMin = "0.0"), Category = "General")
-		float Delay = 0.0f;
 	FAsyncTaskDelegate TaskDelegate;
 protected:
-	virtual void Tick(float DeltaTime) override;
-
-protected:
-	bool bStarted = false;
-	float TimeRemaining = 0.0f;
+	virtual bool HasPendingIterations() const override;
+	virtual void ExecuteIteration() override;
 };
 
 
@@ -50,7 +43,7 @@ private:
 	bool bStarted;
 public:
 
-	FMultiFrameAsyncTaskAction(UObject* InObject, EMultiTask2BranchesNoCompleteWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameAsyncTask> TaskClass, const int32 InIterationsPerTick, const float InDelay, UMultiFrameAsyncTask*& OutTask)
+	FMultiFrameAsyncTaskAction(UObject* InObject, EMultiTask2BranchesNoCompleteWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameAsyncTask> TaskClass, const int32 InIterationsPerTick, const float InDelay, const float InTimeBudget, UMultiFrameAsyncTask*& OutTask)
 		: FSingleTaskActionBase(InObject, LatentInfo, TaskClass)
 		, Branches(InBranches)
 		, bStarted(false)
@@ -64,6 +57,7 @@ public:
 			OutTask->BodyFunction();
 			OutTask->IterationsPerTick = InIterationsPerTick;
 			OutTask->Delay = InDelay;
+			OutTask->TimeBudget = InTimeBudget;
 			bStarted = Task->Start();
 		}
 		else {
@@ -0,0 +1,72 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "CoreMinimal.h"
+#include "MultiFrameGridWalker.generated.h"
+
+UENUM(BlueprintType)
+enum class EMultiFrameLoopOrder : uint8
+{
+	/** Row by row, X first. */
+	Linear,
+	/** Row by row inside square (cubic) tiles of Tile Size, tiles row by row. */
+	Tiled,
+	/** Z-order curve. Cells close on the curve are close in the grid at every scale. */
+	Morton,
+	/** Hilbert curve over X and Y, slice by slice along Z. Better locality than Morton, at a higher cost per step. */
+	Hilbert,
+};
+
+/**
+* Walks every cell of a 3D grid exactly once in the chosen order.
+* Each step derives the next cell from the current one, without dividing a linear index by the grid size.
+*/
+struct MULTITASK2_API FMultiFrameGridWalker
+{
+public:
+	void Reset(EMultiFrameLoopOrder InOrder, const FIntVector& InSize, int32 InTileSize);
+
+	/**
+	* Move to the next cell. Does nothing once every cell was visited.
+	*/
+	void Next();
+
+	const FIntVector& GetCell() const
+	{
+		return Cell;
+	}
+
+	bool IsDone() const
+	{
+		return bDone;
+	}
+
+private:
+	bool IsInside() const
+	{
+		return Cell.X < Size.X && Cell.Y < Size.Y && Cell.Z < Size.Z;
+	}
+
+	void NextLinear();
+	void NextTiled();
+	void NextMorton();
+	void NextHilbert();
+	void DecodeHilbert();
+
+private:
+	EMultiFrameLoopOrder Order = EMultiFrameLoopOrder::Linear;
+	FIntVector Size = FIntVector(0);
+	FIntVector Cell = FIntVector(0);
+	bool bDone = true;
+
+	// Tiled
+	int32 TileSize = 1;
+	FIntVector TileOrigin = FIntVector(0);
+
+	// Morton: axis (high bits) and bit index (low 5 bits) of every code bit, least significant first.
+	TArray<uint8, TInlineAllocator<96>> MortonBits;
+
+	// Hilbert: square blocks of a power of two side, laid out row by row over X and Y.
+	int32 HilbertSide = 1;
+	int64 HilbertIndex = 0;
+	FIntVector HilbertOrigin = FIntVector(0);
+};
@@ -1,12 +1,12 @@
 // Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
 #pragma once
-#include "MultiTaskBase.h"
+#include "MultiFrameTaskBase.h"
 #include "MultiFrameLoop1DTask.generated.h"
 
 DECLARE_MULTICAST_DELEGATE(FLoop1DTaskDelegate);
 
 UCLASS(Blueprintable, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "True"))
-class MULTITASK2_API UMultiFrameLoop1DTask : public UMultiTaskBase
+class MULTITASK2_API UMultiFrameLoop1DTask : public UMultiFrameTaskBase
 {
 	friend class FMultiFrameLoop1DTaskAction;
     GENERATED_BODY()
@@ -32,18 +32,13 @@ public:
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
         int32 XSize = 1;
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
-        int32 IterationsPerTick = 1;
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "0.0", UIMin = "0.0"), Category = "General")
-        float Delay = 0.0f;
     FLoop1DTaskDelegate TaskDelegate;
 protected:
-    virtual void Tick(float DeltaTime) override;
+    virtual bool HasPendingIterations() const override;
+    virtual void ExecuteIteration() override;
 
 protected:
     int32 CurrentIndex = 0;
-    bool bStarted = false;
-    float TimeRemaining = 0.0f;
 };
 
 
@@ -56,7 +51,7 @@ private:
 	bool bStarted;
 public:
 
-	FMultiFrameLoop1DTaskAction(UObject* InObject, EMultiTask2BranchesWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameLoop1DTask> TaskClass, int32& InCurrentX, const int32 InXSize, const int32 InIterationsPerTick, const float InDelay, UMultiFrameLoop1DTask*& OutTask)
+	FMultiFrameLoop1DTaskAction(UObject* InObject, EMultiTask2BranchesWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameLoop1DTask> TaskClass, int32& InCurrentX, const int32 InXSize, const int32 InIterationsPerTick, const float InDelay, const float InTimeBudget, UMultiFrameLoop1DTask*& OutTask)
 		: FSingleTaskActionBase(InObject, LatentInfo, TaskClass)
 		, CurrentX(InCurrentX)
 		, XSize(InXSize)
@@ -73,6 +68,7 @@ public:
 			OutTask->XSize = InXSize;
 			OutTask->IterationsPerTick = InIterationsPerTick;
 			OutTask->Delay = InDelay;
+			OutTask->TimeBudget = InTimeBudget;
 			bStarted = Task->Start();
 		}
 		else {
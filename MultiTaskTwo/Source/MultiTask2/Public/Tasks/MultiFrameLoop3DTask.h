@@ -1,12 +1,13 @@
 // Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
 #pragma once
-#include "MultiTaskBase.h"
+#include "MultiFrameTaskBase.h"
+#include "MultiFrameGridWalker.h"
 #include "MultiFrameLoop3DTask.generated.h"
 
 DECLARE_MULTICAST_DELEGATE(FLoop3DTaskDelegate);
 
 UCLASS(Blueprintable, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "True"))
-class MULTITASK2_API UMultiFrameLoop3DTask : public UMultiTaskBase
+class MULTITASK2_API UMultiFrameLoop3DTask : public UMultiFrameTaskBase
 {
 	friend class FMultiFrameLoop3DTaskAction;
     GENERATED_BODY()
@@ -36,18 +37,24 @@ public:
         int32 YSize = 1;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
         int32 ZSize = 1;
+    /**
+    * Order in which cells are visited. Tiled, Morton and Hilbert keep neighbouring cells close in time, which helps bodies sampling grids.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "General")
+        EMultiFrameLoopOrder IterationOrder = EMultiFrameLoopOrder::Linear;
+    /**
+    * Side of the tiles visited one after the other by the Tiled order.
+    */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
-        int32 IterationsPerTick = 1;
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "0.0", UIMin = "0.0"), Category = "General")
-        float Delay = 0.0f;
+        int32 TileSize = 8;
     FLoop3DTaskDelegate TaskDelegate;
 protected:
-    virtual void Tick(float DeltaTime) override;
+    virtual bool HasPendingIterations() const override;
+    virtual void ExecuteIteration() override;
 
 protected:
     int32 CurrentIndex = 0;
-    bool bStarted = false;
-    float TimeRemaining = 0.0f;
+    FMultiFrameGridWalker Walker;
 };
 
 
@@ -64,7 +71,7 @@ private:
 	bool bStarted;
 public:
 
-	FMultiFrameLoop3DTaskAction(UObject* InObject, EMultiTask2BranchesWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameLoop3DTask> TaskClass, int32& InCurrentX, int32& InCurrentY, int32& InCurrentZ, const int32 InXSize, const int32 InYSize, const int32 InZSize, const int32 InIterationsPerTick, const float InDelay, UMultiFrameLoop3DTask*& OutTask)
+	FMultiFrameLoop3DTaskAction(UObject* InObject, EMultiTask2BranchesWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameLoop3DTask> TaskClass, int32& InCurrentX, int32& InCurrentY, int32& InCurrentZ, const int32 InXSize, const int32 InYSize, const int32 InZSize, const int32 InIterationsPerTick, const float InDelay, const float InTimeBudget, const EMultiFrameLoopOrder InIterationOrder, const int32 InTileSize, UMultiFrameLoop3DTask*& OutTask)
 		: FSingleTaskActionBase(InObject, LatentInfo, TaskClass)
 		, CurrentX(InCurrentX)
 		, CurrentY(InCurrentY)
@@ -85,6 +92,9 @@ public:
 			OutTask->ZSize = InZSize;
 			OutTask->IterationsPerTick = InIterationsPerTick;
 			OutTask->Delay = InDelay;
+			OutTask->TimeBudget = InTimeBudget;
+			OutTask->IterationOrder = InIterationOrder;
+			OutTask->TileSize = InTileSize;
 			bStarted = Task->Start();
 		}
 		else {
@@ -96,9 +106,9 @@ public:
 			OutTask->TaskDelegate.AddLambda([OutTask, &InBranches, &InCurrentX, &InCurrentY, &InCurrentZ]
 			{
 				InBranches = EMultiTask2BranchesWithBody::OnTaskBody;
-				InCurrentX = OutTask->CurrentIndex % OutTask->XSize;
-				InCurrentY = (OutTask->CurrentIndex / OutTask->XSize) % OutTask->YSize;
-				InCurrentZ = OutTask->CurrentIndex / (OutTask->XSize * OutTask->YSize);
+				InCurrentX = OutTask->Walker.GetCell().X;
+				InCurrentY = OutTask->Walker.GetCell().Y;
+				InCurrentZ = OutTask->Walker.GetCell().Z;
 				OutTask->BodyFunction();
 			});
 		}
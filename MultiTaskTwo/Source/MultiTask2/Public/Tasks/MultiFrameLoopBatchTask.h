@@ -0,0 +1,142 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "MultiFrameTaskBase.h"
+#include "MultiFrameLoopBatchTask.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_FourParams(FLoopBatchTaskDelegate, int32, int32, int32, int32);
+
+/**
+* Multi-Frame Loop calling its body once per batch of contiguous indices instead of once per index.
+* A batch is a span of up to Batch Size indices along X and never crosses a row, so Y and Z are constant inside it.
+* Iterations Per Tick counts batches.
+*/
+UCLASS(Blueprintable, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "True"))
+class MULTITASK2_API UMultiFrameLoopBatchTask : public UMultiFrameTaskBase
+{
+	friend class FMultiFrameLoopBatchTaskAction;
+    GENERATED_BODY()
+
+public:
+    UMultiFrameLoopBatchTask();
+    ~UMultiFrameLoopBatchTask();
+
+    virtual bool Start() override;
+
+    /**
+    * Called on Game Thread on each batch.
+    * @param FirstX	First X index of the batch.
+    * @param LastX	Last X index of the batch, inclusive.
+    */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, meta = (DisplayName = "Task Body"), Category = "Events")
+        void TaskBody(int32 FirstX, int32 LastX, int32 Y, int32 Z);
+    virtual void TaskBody_Implementation(int32 FirstX, int32 LastX, int32 Y, int32 Z);
+
+    /**
+    * Check whether the job is in progress.
+    */
+    virtual bool IsRunning() override;
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 XSize = 1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 YSize = 1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 ZSize = 1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 BatchSize = 64;
+    FLoopBatchTaskDelegate TaskDelegate;
+protected:
+    virtual bool HasPendingIterations() const override;
+    virtual void ExecuteIteration() override;
+
+protected:
+    int32 CurrentX = 0;
+    int32 CurrentY = 0;
+    int32 CurrentZ = 0;
+};
+
+
+
+class MULTITASK2_API FMultiFrameLoopBatchTaskAction : public FSingleTaskActionBase
+{
+private:
+	EMultiTask2BranchesWithBody& Branches;
+	bool bStarted;
+public:
+
+	FMultiFrameLoopBatchTaskAction(UObject* InObject, EMultiTask2BranchesWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameLoopBatchTask> TaskClass, int32& InFirstX, int32& InLastX, int32& InCurrentY, int32& InCurrentZ, const int32 InXSize, const int32 InYSize, const int32 InZSize, const int32 InBatchSize, const int32 InIterationsPerTick, const float InDelay, const float InTimeBudget, UMultiFrameLoopBatchTask*& OutTask)
+		: FSingleTaskActionBase(InObject, LatentInfo, TaskClass)
+		, Branches(InBranches)
+		, bStarted(false)
+	{
+
+		OutTask = Cast<UMultiFrameLoopBatchTask>(Task);
+
+		if (OutTask)
+		{
+			Branches = EMultiTask2BranchesWithBody::OnStart;
+			OutTask->BodyFunction();
+			OutTask->XSize = InXSize;
+			OutTask->YSize = InYSize;
+			OutTask->ZSize = InZSize;
+			OutTask->BatchSize = InBatchSize;
+			OutTask->IterationsPerTick = InIterationsPerTick;
+			OutTask->Delay = InDelay;
+			OutTask->TimeBudget = InTimeBudget;
+			bStarted = Task->Start();
+		}
+		else {
+			return;
+		}
+
+		if (bStarted)
+		{
+			OutTask->TaskDelegate.AddLambda([OutTask, &InBranches, &InFirstX, &InLastX, &InCurrentY, &InCurrentZ](int32 FirstX, int32 LastX, int32 Y, int32 Z)
+			{
+				InBranches = EMultiTask2BranchesWithBody::OnTaskBody;
+				InFirstX = FirstX;
+				InLastX = LastX;
+				InCurrentY = Y;
+				InCurrentZ = Z;
+				OutTask->BodyFunction();
+			});
+		}
+	}
+
+	virtual ~FMultiFrameLoopBatchTaskAction()
+	{
+		if (IsValid(Task) && !Task->HasAnyFlags(RF_BeginDestroyed) && !Task->IsUnreachable())
+		{
+			UMultiFrameLoopBatchTask* LocalTask = Cast<UMultiFrameLoopBatchTask>(Task);
+			if (LocalTask)
+			{
+				LocalTask->TaskDelegate.RemoveAll(this);
+			}
+		}
+	}
+
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		if (bStarted)
+		{
+			if (!IsCanceled())
+			{
+				if (!IsRunning())
+				{
+					Branches = EMultiTask2BranchesWithBody::OnCompleted;
+					Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+				}
+			}
+			else {
+				Branches = EMultiTask2BranchesWithBody::OnCanceled;
+				Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+			}
+		}
+		else {
+			//If we reached this point it means the task was unable to start.
+			Branches = EMultiTask2BranchesWithBody::OnCompleted;
+			Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+		}
+	}
+};
@@ -0,0 +1,159 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "MultiFrameTaskBase.h"
+#include "MultiFrameParallelLoopTask.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FParallelLoopTaskDelegate, int32, int32);
+
+struct FMultiFrameParallelSlice;
+
+/**
+* Multi-Frame Loop whose Task Body runs in parallel on worker threads.
+* Each frame the previous slice of the index space is joined on Game Thread, reported through the Task Delegate, and the next slice is launched.
+* Workers keep running while Game Thread does the rest of its frame, so the loop is both amortized and multi-core.
+* The Task Body must be thread safe.
+*/
+UCLASS(Blueprintable, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "True"))
+class MULTITASK2_API UMultiFrameParallelLoopTask : public UMultiFrameTaskBase
+{
+	friend class FMultiFrameParallelLoopTaskAction;
+    GENERATED_BODY()
+
+public:
+    UMultiFrameParallelLoopTask();
+    ~UMultiFrameParallelLoopTask();
+
+    virtual bool Start() override;
+
+    /**
+    * Called on Background Threads, in parallel, on each index.
+    */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, meta = (DisplayName = "Task Body"), Category = "Events")
+        void TaskBody(int32 X, int32 Y, int32 Z);
+    virtual void TaskBody_Implementation(int32 X, int32 Y, int32 Z);
+
+    /**
+    * Check whether the job is in progress.
+    */
+    virtual bool IsRunning() override;
+
+    virtual void BeginDestroy() override;
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 XSize = 1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 YSize = 1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 ZSize = 1;
+    /**
+    * Amount of indices processed in parallel between two Game Thread sync points.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 SliceSize = 1024;
+    /**
+    * Thread Pool running the slices, at the Task's Priority. If Null, the Task Graph workers are used.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General")
+        UMultiTaskThreadPool* ThreadPool = nullptr;
+
+    /**
+    * Broadcast on Game Thread with the first and last linear index of every joined slice.
+    */
+    FParallelLoopTaskDelegate TaskDelegate;
+protected:
+    virtual bool HasPendingIterations() const override;
+    virtual void ExecuteIteration() override;
+
+private:
+    void LaunchSlice(int32 First, int32 Count);
+    bool IsSliceInFlight() const;
+
+protected:
+    int32 CurrentIndex = 0;
+
+private:
+    TSharedPtr<FMultiFrameParallelSlice, ESPMode::ThreadSafe> Slice;
+};
+
+
+
+class MULTITASK2_API FMultiFrameParallelLoopTaskAction : public FSingleTaskActionBase
+{
+private:
+	EMultiTask2BranchesWithBody& Branches;
+	bool bStarted;
+public:
+
+	FMultiFrameParallelLoopTaskAction(UObject* InObject, EMultiTask2BranchesWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameParallelLoopTask> TaskClass, int32& InFirstIndex, int32& InLastIndex, const int32 InXSize, const int32 InYSize, const int32 InZSize, const int32 InSliceSize, const float InDelay, UMultiTaskThreadPool* InThreadPool, UMultiFrameParallelLoopTask*& OutTask)
+		: FSingleTaskActionBase(InObject, LatentInfo, TaskClass)
+		, Branches(InBranches)
+		, bStarted(false)
+	{
+
+		OutTask = Cast<UMultiFrameParallelLoopTask>(Task);
+
+		if (OutTask)
+		{
+			Branches = EMultiTask2BranchesWithBody::OnStart;
+			OutTask->BodyFunction();
+			OutTask->XSize = InXSize;
+			OutTask->YSize = InYSize;
+			OutTask->ZSize = InZSize;
+			OutTask->SliceSize = InSliceSize;
+			OutTask->Delay = InDelay;
+			OutTask->ThreadPool = InThreadPool;
+			bStarted = Task->Start();
+		}
+		else {
+			return;
+		}
+
+		if (bStarted)
+		{
+			OutTask->TaskDelegate.AddLambda([OutTask, &InBranches, &InFirstIndex, &InLastIndex](int32 FirstIndex, int32 LastIndex)
+			{
+				InBranches = EMultiTask2BranchesWithBody::OnTaskBody;
+				InFirstIndex = FirstIndex;
+				InLastIndex = LastIndex;
+				OutTask->BodyFunction();
+			});
+		}
+	}
+
+	virtual ~FMultiFrameParallelLoopTaskAction()
+	{
+		if (IsValid(Task) && !Task->HasAnyFlags(RF_BeginDestroyed) && !Task->IsUnreachable())
+		{
+			UMultiFrameParallelLoopTask* LocalTask = Cast<UMultiFrameParallelLoopTask>(Task);
+			if (LocalTask)
+			{
+				LocalTask->TaskDelegate.RemoveAll(this);
+			}
+		}
+	}
+
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		if (bStarted)
+		{
+			if (!IsCanceled())
+			{
+				if (!IsRunning())
+				{
+					Branches = EMultiTask2BranchesWithBody::OnCompleted;
+					Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+				}
+			}
+			else {
+				Branches = EMultiTask2BranchesWithBody::OnCanceled;
+				Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+			}
+		}
+		else {
+			//If we reached this point it means the task was unable to start.
+			Branches = EMultiTask2BranchesWithBody::OnCompleted;
+			Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+		}
+	}
+};
@@ -0,0 +1,150 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "MultiFrameTaskBase.h"
+#include "MultiFrameSparseLoopTask.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_FourParams(FSparseLoopTaskDelegate, int32, int32, int32, int32);
+
+/**
+* Multi-Frame Loop visiting only selected cells of a grid, so incremental updates cost proportional to the amount of dirty cells.
+* Every index of Indices is visited first, then every set bit of Mask. Bit B of word W in Mask is the linear index W * 64 + B,
+* words without set bits are skipped as a whole.
+*/
+UCLASS(Blueprintable, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "True"))
+class MULTITASK2_API UMultiFrameSparseLoopTask : public UMultiFrameTaskBase
+{
+	friend class FMultiFrameSparseLoopTaskAction;
+    GENERATED_BODY()
+
+public:
+    UMultiFrameSparseLoopTask();
+    ~UMultiFrameSparseLoopTask();
+
+    virtual bool Start() override;
+
+    /**
+    * Called on Game Thread on each selected index.
+    * @param Index	Linear index, X + Y * XSize + Z * XSize * YSize.
+    */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, meta = (DisplayName = "Task Body"), Category = "Events")
+        void TaskBody(int32 Index, int32 X, int32 Y, int32 Z);
+    virtual void TaskBody_Implementation(int32 Index, int32 X, int32 Y, int32 Z);
+
+    /**
+    * Check whether the job is in progress.
+    */
+    virtual bool IsRunning() override;
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 XSize = 1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 YSize = 1;
+    /**
+    * Linear indices to visit, in order. Negative indices are skipped.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "General")
+        TArray<int32> Indices;
+    /**
+    * Bit mask of linear indices to visit, 64 per word.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "General")
+        TArray<int64> Mask;
+    FSparseLoopTaskDelegate TaskDelegate;
+protected:
+    virtual bool HasPendingIterations() const override;
+    virtual void ExecuteIteration() override;
+
+private:
+    void SkipIndicesAndEmptyWords();
+
+protected:
+    int32 IndicesPosition = 0;
+    int32 MaskWord = 0;
+    uint64 MaskBits = 0;
+};
+
+
+
+class MULTITASK2_API FMultiFrameSparseLoopTaskAction : public FSingleTaskActionBase
+{
+private:
+	EMultiTask2BranchesWithBody& Branches;
+	bool bStarted;
+public:
+
+	FMultiFrameSparseLoopTaskAction(UObject* InObject, EMultiTask2BranchesWithBody& InBranches, const FLatentActionInfo& LatentInfo, TSubclassOf<class UMultiFrameSparseLoopTask> TaskClass, int32& InCurrentIndex, int32& InCurrentX, int32& InCurrentY, int32& InCurrentZ, const TArray<int32>& InIndices, const TArray<int64>& InMask, const int32 InXSize, const int32 InYSize, const int32 InIterationsPerTick, const float InDelay, const float InTimeBudget, UMultiFrameSparseLoopTask*& OutTask)
+		: FSingleTaskActionBase(InObject, LatentInfo, TaskClass)
+		, Branches(InBranches)
+		, bStarted(false)
+	{
+
+		OutTask = Cast<UMultiFrameSparseLoopTask>(Task);
+
+		if (OutTask)
+		{
+			Branches = EMultiTask2BranchesWithBody::OnStart;
+			OutTask->BodyFunction();
+			OutTask->Indices = InIndices;
+			OutTask->Mask = InMask;
+			OutTask->XSize = InXSize;
+			OutTask->YSize = InYSize;
+			OutTask->IterationsPerTick = InIterationsPerTick;
+			OutTask->Delay = InDelay;
+			OutTask->TimeBudget = InTimeBudget;
+			bStarted = Task->Start();
+		}
+		else {
+			return;
+		}
+
+		if (bStarted)
+		{
+			OutTask->TaskDelegate.AddLambda([OutTask, &InBranches, &InCurrentIndex, &InCurrentX, &InCurrentY, &InCurrentZ](int32 Index, int32 X, int32 Y, int32 Z)
+			{
+				InBranches = EMultiTask2BranchesWithBody::OnTaskBody;
+				InCurrentIndex = Index;
+				InCurrentX = X;
+				InCurrentY = Y;
+				InCurrentZ = Z;
+				OutTask->BodyFunction();
+			});
+		}
+	}
+
+	virtual ~FMultiFrameSparseLoopTaskAction()
+	{
+		if (IsValid(Task) && !Task->HasAnyFlags(RF_BeginDestroyed) && !Task->IsUnreachable())
+		{
+			UMultiFrameSparseLoopTask* LocalTask = Cast<UMultiFrameSparseLoopTask>(Task);
+			if (LocalTask)
+			{
+				LocalTask->TaskDelegate.RemoveAll(this);
+			}
+		}
+	}
+
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		if (bStarted)
+		{
+			if (!IsCanceled())
+			{
+				if (!IsRunning())
+				{
+					Branches = EMultiTask2BranchesWithBody::OnCompleted;
+					Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+				}
+			}
+			else {
+				Branches = EMultiTask2BranchesWithBody::OnCanceled;
+				Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+			}
+		}
+		else {
+			//If we reached this point it means the task was unable to start.
+			Branches = EMultiTask2BranchesWithBody::OnCompleted;
+			Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+		}
+	}
+};
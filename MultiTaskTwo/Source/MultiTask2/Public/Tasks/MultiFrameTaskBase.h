@@ -0,0 +1,86 @@
+// Copyright 2017-2022 S.C. Pug Life Studio S.R.L. All Rights Reserved.
+#pragma once
+#include "MultiTaskBase.h"
+#include "MultiTaskThreadPool.h"
+#include "MultiFrameTaskBase.generated.h"
+
+/**
+* Base for Tasks amortizing their iterations over multiple frames on Game Thread.
+* Running Tasks are served by the Multi-Frame Scheduler instead of ticking on their own.
+*/
+UCLASS(Abstract, HideDropdown, NotBlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "True"))
+class MULTITASK2_API UMultiFrameTaskBase : public UMultiTaskBase
+{
+    friend class UMultiFrameTaskScheduler;
+    GENERATED_BODY()
+
+public:
+    UMultiFrameTaskBase();
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 IterationsPerTick = 1;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "0.0", UIMin = "0.0"), Category = "General")
+        float Delay = 0.0f;
+    /**
+    * Milliseconds of Game Thread time spent on iterations per frame. When higher than 0 it replaces Iterations Per Tick,
+    * so the amount of work per frame adapts to the cost of the Task Body and the speed of the machine.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true, ClampMin = "0.0", UIMin = "0.0"), Category = "General")
+        float TimeBudget = 0.0f;
+    /**
+    * With a Time Budget, the clock is read once every this many iterations. Raise it for very cheap Task Bodies.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "1", UIMin = "1"), Category = "General")
+        int32 TimeCheckInterval = 8;
+    /**
+    * Order in which the Multi-Frame Scheduler serves this Task when the shared frame budget is tight. Set it before the Task starts.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General")
+        EMultiTaskWorkPriority Priority = EMultiTaskWorkPriority::Normal;
+    /**
+    * Serve this Task from a tick function in Tick Group instead of at the end of the frame,
+    * e.g. to overlap amortized work with the render thread before physics. Set it before the Task starts.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tick")
+        bool bUseTickGroup = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (EditCondition = "bUseTickGroup"), Category = "Tick")
+        TEnumAsByte<ETickingGroup> TickGroup = TG_PrePhysics;
+
+protected:
+    virtual ETickableTickType GetTickableTickType() const override;
+
+    /**
+    * Hand the Task over to the Multi-Frame Scheduler. Called once the Task started.
+    */
+    void Schedule();
+
+    /**
+    * Count down the Delay.
+    * @return True if iterations are due this frame.
+    */
+    bool AdvanceDelay(float DeltaTime);
+
+    /**
+    * Run the iterations of one frame, limited by Iterations Per Tick or Time Budget.
+    * @param FrameEndTime	Time at which the scheduler's shared budget is spent, 0 for none.
+    */
+    void RunIterations(double FrameEndTime);
+
+    /**
+    * Whether there are iterations left to execute.
+    */
+    virtual bool HasPendingIterations() const;
+
+    /**
+    * Execute exactly one iteration and advance to the next one.
+    */
+    virtual void ExecuteIteration();
+
+protected:
+    bool bStarted = false;
+    float TimeRemaining = 0.0f;
+
+private:
+    uint64 LastServedFrame = 0;
+};
@@ -8,12 +8,17 @@
 #include "LatentActions.h"
 #include "Engine/LatentActionManager.h"
 #include "Templates/SubclassOf.h"
+#include "Engine/EngineTypes.h"
 #include "UObject/Package.h"
 #include "MultiTask2UtilitiesLibrary.h"
 #include "MultiTaskBase.generated.h"
 
 DECLARE_MULTICAST_DELEGATE(FMultiTaskOnCancelDelegate);
 
+class UMultiTaskGroup;
+class AActor;
+class ULevel;
+
 UCLASS(HideDropdown, BlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
 class MULTITASK2_API UMultiTaskBase : public UObject, public FTickableGameObject
 {
@@ -40,10 +45,21 @@ public:
     virtual bool IsRunning();
 
     /**
-    * Check whether the task is canceled.
+    * Check whether the task is canceled, either directly or through its Group.
     */
     virtual bool IsCanceled();
 
+    virtual void BeginDestroy() override;
+
+    /**
+    * Cancel the Task automatically when the owner goes away.
+    * Actors (and components, through their actor) end the lifetime when they end play, e.g. when their level or World Partition cell streams out.
+    * Levels end it when they are removed from the world. Other objects are bound to the level they belong to.
+    * @param Owner	Object whose lifetime the Task is bound to.
+    */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bind To Lifetime"), Category = "Task")
+        void BindToLifetime(UObject* Owner);
+
     /**
     * Called immediately on Game Thread when the Task is cancelled. 
     */
@@ -66,6 +82,12 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tick")
         bool bIsTickableWhenPaused = false;
 
+    /**
+    * Group tracking the work of this Task. Set it before the Task starts, e.g. from the On Start branch.
+    */
+    UPROPERTY(BlueprintReadWrite, Category = "General")
+        UMultiTaskGroup* Group = nullptr;
+
     FMultiTaskOnCancelDelegate OnCancelDelegate;
     TFunction<void()> BodyFunction;
 protected:
@@ -79,9 +101,37 @@ protected:
 private:
     virtual TStatId GetStatId() const override;
 
+protected:
+    /**
+    * Called on Game Thread when the object the Task is bound to goes away.
+    */
+    virtual void OnLifetimeEnded();
+
+    /**
+    * Flag the Task as canceled and notify On Cancel on Game Thread, regardless of its running state.
+    */
+    void MarkCanceled();
+
+    /**
+    * Register one unit of work with the Group. Used by tasks progressing on Game Thread.
+    */
+    void EnterGroup();
+    void LeaveGroup();
+
 protected:
 	FThreadSafeBool bCanceled = false;
 
+private:
+    UFUNCTION()
+        void OnLifetimeActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+    void OnLifetimeLevelRemoved(ULevel* Level, UWorld* World);
+
+    UPROPERTY(Transient)
+        UMultiTaskGroup* RunningGroup = nullptr;
+
+    TWeakObjectPtr<ULevel> LifetimeLevel;
+    FDelegateHandle LevelRemovedHandle;
+
 };
 
 
@@ -22,6 +22,21 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, meta = (DisplayName = "Task Body"), Category = "Events")
 		void TaskBody();
 	virtual void TaskBody_Implementation();
+
+	/**
+	* Run Child Body Count times in parallel on the Task's Thread Pool and wait until all of them finished.
+	* The calling thread executes children too while waiting instead of idling. Call it from Task Body.
+	* @param Count	Amount of children.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe, DisplayName = "Fork Join Children"), Category = "Task")
+		void ForkJoinChildren(int32 Count);
+
+	/**
+	* Called on Background Thread once for every child forked by Fork Join Children.
+	*/
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, meta = (DisplayName = "Child Body"), Category = "Events")
+		void ChildBody(int32 Index);
+	virtual void ChildBody_Implementation(int32 Index);
 public:
 	FMultiThreadTaskDelegate TaskDelegate;
 };
@@ -176,6 +191,8 @@ public:
 		Branches = EMultiTask2BranchesNoCancel::OnStart;
 		BodyFunction();
 
+		//Launch as one batch so the Thread Pool can order the work longest-expected-first.
+		FMultiTaskPoolBatchScope BatchScope(IsValid(ThreadPool) && InExecutionType == ETaskExecutionType::ThreadPool ? ThreadPool : nullptr);
 		int32 TasksStarted = 0;
 		for (auto Task : Tasks)
 		{
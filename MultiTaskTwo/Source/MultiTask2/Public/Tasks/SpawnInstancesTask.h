@@ -4,12 +4,21 @@
 #include "MultiThreadTask.h"
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "AI/NavigationSystemBase.h"
+#include "MultiTaskBuffers.h"
 #ifndef ENGINE_MINOR_VERSION
 #include "Runtime/Launch/Resources/Version.h"
 #endif
 #include "SpawnInstancesTask.generated.h"
 
-
+/**
+* What one chunk produced, written once by its worker when the chunk is done.
+* Aligned to a cache line so workers finishing at the same time do not contend.
+*/
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FSpawnInstancesChunkResult
+{
+	FBox Bounds = FBox(ForceInit);
+	int32 InstancesNum = 0;
+};
 
 UCLASS(HideDropdown, NotBlueprintable, NotBlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
 class MULTITASK2_API USpawnInstancesTask : public UMultiThreadTask
@@ -29,9 +38,16 @@ public:
 private:
 	void CreatePhysicsBodies();
 
+	/**
+	* Reduce the per-chunk results once every chunk is done.
+	* @return True if every instance was built.
+	*/
+	bool MergeChunkResults();
+
 private:
 
 	TArray<FTransform> InstancesTransforms;
+	TMultiTaskImmutableBuffer<FTransform> SharedTransforms;
 	int32 TransformArraySize = 0;
 	FTransform* TransformPtr = NULL;
 
@@ -49,6 +65,8 @@ private:
 	TArray<FBox> UnbuiltInstanceBoundsList;
 	TArray<FInstanceUpdateCmdBuffer::FInstanceUpdateCommand> Cmds;
 	FBox UnbuiltInstanceBounds;
+	TArray<FSpawnInstancesChunkResult> ChunkResults;
+	int32 SpawnedInstancesNum = 0;
 	TArray<int32>* NewInstances;
 };
 
@@ -86,20 +104,53 @@ public:
 				}
 			}
 			LocalTask->bCreateInternalDataCopies = bCreateInternalDataCopies;
-			NewInstances.Empty();
-			LocalTask->HISM = HISM;
-			LocalTask->bWorldSpace = bWorldSpace;
-			LocalTask->TaskCount = TaskCount;
-			LocalTask->ExecutionType = InExecutionType;
-			LocalTask->ThreadPool = ThreadPool;
-			LocalTask->NewInstances = &NewInstances;
-			bStarted = Task->Start();
+			StartTask(LocalTask, TaskCount, HISM, bWorldSpace, InExecutionType, ThreadPool, NewInstances);
+		}
+		else {
+			return;
+		}
+	}
+
+	FSpawnInstancesTaskAction(UObject* InObject, EMultiTask2Branches& InBranches, const FLatentActionInfo& LatentInfo, int32 TaskCount, UHierarchicalInstancedStaticMeshComponent* HISM, const FMultiTaskTransformBuffer& InstancesTransforms, bool bWorldSpace, bool InCreatePhysicsBodies, const ETaskExecutionType& InExecutionType, UMultiTaskThreadPool* ThreadPool, UMultiTaskBase*& OutTask, TArray<int32>& NewInstances)
+		: FSingleTaskActionBase(InObject, LatentInfo, USpawnInstancesTask::StaticClass())
+		, Branches(InBranches)
+		, bStarted(false)
+		, bCreatePhysicsBodies(InCreatePhysicsBodies)
+	{
+		OutTask = Task;
+
+		USpawnInstancesTask* LocalTask = Cast<USpawnInstancesTask>(Task);
+		if (LocalTask)
+		{
+			Branches = EMultiTask2Branches::OnStart;
+			LocalTask->BodyFunction();
+			// The task keeps a reference to the immutable buffer, so it is safe to read without a copy.
+			LocalTask->SharedTransforms = InstancesTransforms.Buffer;
+			LocalTask->TransformArraySize = LocalTask->SharedTransforms.Num();
+			LocalTask->TransformPtr = const_cast<FTransform*>(LocalTask->SharedTransforms.GetData());
+			LocalTask->bCreateInternalDataCopies = false;
+			StartTask(LocalTask, TaskCount, HISM, bWorldSpace, InExecutionType, ThreadPool, NewInstances);
 		}
 		else {
 			return;
 		}
 	}
 
+private:
+	void StartTask(USpawnInstancesTask* LocalTask, int32 TaskCount, UHierarchicalInstancedStaticMeshComponent* HISM, bool bWorldSpace, const ETaskExecutionType& InExecutionType, UMultiTaskThreadPool* ThreadPool, TArray<int32>& NewInstances)
+	{
+		NewInstances.Empty();
+		LocalTask->HISM = HISM;
+		LocalTask->bWorldSpace = bWorldSpace;
+		LocalTask->TaskCount = TaskCount;
+		LocalTask->ExecutionType = InExecutionType;
+		LocalTask->ThreadPool = ThreadPool;
+		LocalTask->NewInstances = &NewInstances;
+		bStarted = Task->Start();
+	}
+
+public:
+
 	virtual void UpdateOperation(FLatentResponse& Response) override
 	{
 				if (bStarted)
@@ -111,7 +162,12 @@ public:
 					USpawnInstancesTask* LocalTask = Cast<USpawnInstancesTask>(Task);
 					if (LocalTask)
 					{
-						if (LocalTask->HISM)
+						// A chunk that stopped early left zeroed instances behind, nothing is added in that case.
+						if (!LocalTask->MergeChunkResults())
+						{
+							LocalTask->NewInstances->Empty();
+						}
+						else if (LocalTask->HISM)
 						{
 							LocalTask->Modify();
 							if (bCreatePhysicsBodies)
@@ -143,11 +199,13 @@ public:
 						{
 							LocalTask->InstancesTransforms.Empty();
 						}
+						LocalTask->SharedTransforms.Reset();
 						LocalTask->PerInstanceSMData.Empty();
 						LocalTask->InstanceBodies.Empty();
 						LocalTask->InstanceReorderTable.Empty();
 						LocalTask->UnbuiltInstanceBoundsList.Empty();
 						LocalTask->Cmds.Empty();
+						LocalTask->ChunkResults.Empty();
 
 					}
 					Branches = EMultiTask2Branches::OnCompleted;
@@ -163,11 +221,13 @@ public:
 					{
 						LocalTask->InstancesTransforms.Empty();
 					}
+					LocalTask->SharedTransforms.Reset();
 					LocalTask->PerInstanceSMData.Empty();
 					LocalTask->InstanceBodies.Empty();
 					LocalTask->InstanceReorderTable.Empty();
 					LocalTask->UnbuiltInstanceBoundsList.Empty();
 					LocalTask->Cmds.Empty();
+					LocalTask->ChunkResults.Empty();
 				}
 				Branches = EMultiTask2Branches::OnCanceled;
 				Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
@@ -181,11 +241,13 @@ public:
 				{
 					LocalTask->InstancesTransforms.Empty();
 				}
+				LocalTask->SharedTransforms.Reset();
 				LocalTask->PerInstanceSMData.Empty();
 				LocalTask->InstanceBodies.Empty();
 				LocalTask->InstanceReorderTable.Empty();
 				LocalTask->UnbuiltInstanceBoundsList.Empty();
 				LocalTask->Cmds.Empty();
+				LocalTask->ChunkResults.Empty();
 			}
 			//If we reached this point it means the task was unable to start.
 			Branches = EMultiTask2Branches::OnCompleted;
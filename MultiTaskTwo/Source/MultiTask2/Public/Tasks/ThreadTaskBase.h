@@ -3,8 +3,12 @@
 #include "CoreMinimal.h"
 #include "MultiTaskBase.h"
 #include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "MultiTaskThreadPool.h"
 #include "ThreadTaskBase.generated.h"
 
+class UMultiTaskPipe;
+
 UENUM(BlueprintType)
 enum class ETaskExecutionType : uint8
 {
@@ -15,10 +19,17 @@ enum class ETaskExecutionType : uint8
     Thread,
 
     /** Execute in global queued thread pool. */
-    ThreadPool
-};
+    ThreadPool,
+
+    /** Execute on high priority Task Graph workers (for short latency sensitive tasks). */
+    TaskGraphHighPriority,
 
-class UMultiTaskThreadPool;
+    /** Execute on background Task Graph workers (for work that must not delay frame critical tasks). */
+    TaskGraphBackground,
+
+    /** Execute with the Tasks System, using the Task's Priority. */
+    Tasks
+};
 
 UCLASS(NotBlueprintType, NotBlueprintable)
 class MULTITASK2_API UThreadTaskBase : public UMultiTaskBase
@@ -34,12 +45,54 @@ public:
     */
     virtual bool IsRunning() override;
 
+    /**
+    * Cancel the Task and drop its work still waiting on the Pipe.
+    */
+    virtual void Cancel() override;
+
 	/**
     * Wait for work job to complete.
     */
     UFUNCTION(BlueprintCallable, meta = (DisplayName = "Wait To Finish"), Category = "Task")
         virtual void WaitToFinish();
 
+    /**
+    * Check whether higher priority work is waiting on the Thread Pool this Task runs on.
+    * Call it periodically from long running Task Bodies.
+    */
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Should Yield"), Category = "Task")
+        bool ShouldYield();
+
+    /**
+    * Cooperative yield point. Waiting higher priority work is executed on the current worker thread, then the Task resumes.
+    * Does nothing on Game Thread or when the Task doesn't run on a Multi Task Thread Pool.
+    * @return True if any work was executed.
+    */
+    UFUNCTION(BlueprintCallable, meta = (BlueprintThreadSafe, DisplayName = "Yield To Pending Work"), Category = "Task")
+        bool YieldToPendingWork();
+
+    /**
+    * Fork Count child jobs into the Task's Thread Pool and join them.
+    * The calling worker executes children itself while joining, so it never idles and small pools can't deadlock.
+    * Helpers never wait for room in a bounded Thread Pool queue, the ones that don't fit are skipped.
+    * Intended to be called from the Task Body.
+    * @param Count		Amount of children.
+    * @param ChildBody	Called once per child index, on any of the participating threads.
+    */
+    void ForkJoin(int32 Count, TFunctionRef<void(int32)> ChildBody);
+
+    /**
+    * Input size used to look up and record execution times for this Task class.
+    */
+    virtual int32 GetWorkSize() const;
+
+    /**
+    * Learned execution time of this Task for its current input size.
+    * @return Expected time in milliseconds, negative if there are no samples yet.
+    */
+    UFUNCTION(BlueprintPure, meta = (BlueprintThreadSafe, DisplayName = "Get Expected Cost"), Category = "Task")
+        float GetExpectedCost();
+
 private:
     void OnEndPIE(bool bIsSimulating);
     void OnPreExit();
@@ -49,6 +102,44 @@ public:
         ETaskExecutionType ExecutionType = ETaskExecutionType::ThreadPool;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General")
         UMultiTaskThreadPool* ThreadPool;
+    /**
+    * Priority used when the Task is queued on a Multi Task Thread Pool or launched with the Tasks System.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General")
+        EMultiTaskWorkPriority Priority = EMultiTaskWorkPriority::Normal;
+    /**
+    * Input size used by the cost model to bucket execution times. 0 lets the Task provide its own estimate.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ClampMin = "0", UIMin = "0"), Category = "General")
+        int32 WorkSize = 0;
+    /**
+    * Serial queue for Tasks sharing a resource. Work on the same Pipe runs one at a time in launch order without blocking worker threads.
+    */
+    UPROPERTY(BlueprintReadWrite, Category = "General")
+        UMultiTaskPipe* Pipe = nullptr;
+    /**
+    * Queued work with the same key is replaced by newer work when the Thread Pool uses the Replace Oldest queue policy.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General")
+        FName CoalesceKey = NAME_None;
+protected:
+    /**
+    * Cancel the Task and drop its work still waiting in the Thread Pool queue.
+    */
+    virtual void OnLifetimeEnded() override;
+
+    /**
+    * Launch work with the Task's Execution Type, Thread Pool and Priority.
+    * The work is tracked by the Task's Group, if any, and its execution time feeds the cost model.
+    * @param InWorkSize	Input size of this work item. INDEX_NONE uses GetWorkSize.
+    */
+    TFuture<void> LaunchWork(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted = nullptr, int32 InWorkSize = INDEX_NONE);
+
+private:
+    TFuture<void> LaunchDirect(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, double ExpectedCost, ETaskExecutionType InExecutionType, UMultiTaskThreadPool* InThreadPool, EMultiTaskWorkPriority InPriority, FName InCoalesceKey);
+    static TFuture<void> LaunchOnTaskGraph(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, ENamedThreads::Type Thread);
+    static TFuture<void> LaunchOnTasks(TUniqueFunction<void()>&& Body, TUniqueFunction<void()>&& OnCompleted, EMultiTaskWorkPriority WorkPriority);
+
 protected:
     TArray<TFuture<void>> Tasks;
 
@@ -35,6 +35,19 @@ static int32 GetCustomDataSize(EMultiTaskCustomDataType DataSize)
 	return 0;
 }
 
+/**
+* Where one chunk wrote its part of the output and what it accumulated, written once by its worker when the chunk is done.
+* Aligned to a cache line so workers finishing at the same time do not contend.
+*/
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FUpdateInstancesChunkResult
+{
+	int32 FirstIndex = 0;
+	int32 CmdsNum = 0;
+	int32 UnbuiltInstancesNum = 0;
+	FBox BuiltInstanceBounds = FBox(ForceInit);
+	FBox UnbuiltInstanceBounds = FBox(ForceInit);
+};
+
 UCLASS(HideDropdown, NotBlueprintable, NotBlueprintType, hidecategories = (Object), meta = (DontUseGenericSpawnObject = "true"))
 class MULTITASK2_API UUpdateInstancesTask : public UMultiThreadTask
 {
@@ -54,6 +67,11 @@ public:
 	void TaskBody(int32 IterationSize, int32 ChunkIndex, int32 ChunkSize);
 private:
 	void UpdatePhysicsBodies();
+
+	/**
+	* Hand the used part of every chunk region to HISM, in chunk order. Called on Game Thread once every chunk is done.
+	*/
+	void ApplyChunkResults();
 public:
 
 private:
@@ -66,6 +84,9 @@ private:
 	int32 CustomDataArraySize = 0;
 	float* CustomDataPtr = NULL;
 	bool bCreateInternalDataCopies;
+	// Custom Data is copied as one block into PerInstanceSMCustomData and picked up by a single tree rebuild, no per instance commands.
+	// The rebuild also reads the new transforms from PerInstanceSMData, so transform commands are skipped as well.
+	bool bPackedCustomData = false;
 
 	int32 StartIndex;
 	int32 TaskCount;
@@ -79,10 +100,9 @@ private:
 	TArray<FInstancedStaticMeshInstanceData> PerInstanceSMData;
 	TArray<FBox> UnbuiltInstanceBoundsList;
 	TArray<FInstanceUpdateCmdBuffer::FInstanceUpdateCommand> Cmds;
-	FBox UnbuiltInstanceBounds;
-	FBox BuiltInstanceBounds;
-
-	FCriticalSection Mutex;
+	TArray<FUpdateInstancesChunkResult> ChunkResults;
+	int32 CmdsPerInstance = 0;
+	int32 UnbuiltInstancesNum = 0;
 };
 
 
@@ -93,7 +113,7 @@ class MULTITASK2_API FUpdateInstancesTaskAction : public FSingleTaskActionBase
 	bool bMarkRenderStateDirty;
 	bool bUpdatePhysicsBodies;
 public:
-	FUpdateInstancesTaskAction(UObject* InObject, EMultiTask2Branches& InBranches, const FLatentActionInfo& LatentInfo, int32 TaskCount, UHierarchicalInstancedStaticMeshComponent* HISM, const int32 StartIndex, const TArray<FTransform>& InstancesTransforms, const void* InCustomData, const int32& CustomDataArraySize, const EMultiTaskCustomDataType DataSize, const bool bWorldSpace, const bool bTeleport, const bool InUpdatePhysicsBodies, const bool InMarkRenderStateDirty, bool bCreateInternalDataCopies, const ETaskExecutionType& InExecutionType, UMultiTaskThreadPool* ThreadPool, UMultiTaskBase*& OutTask)
+	FUpdateInstancesTaskAction(UObject* InObject, EMultiTask2Branches& InBranches, const FLatentActionInfo& LatentInfo, int32 TaskCount, UHierarchicalInstancedStaticMeshComponent* HISM, const int32 StartIndex, const TArray<FTransform>& InstancesTransforms, const void* InCustomData, const int32& CustomDataArraySize, const EMultiTaskCustomDataType DataSize, const bool bWorldSpace, const bool bTeleport, const bool InUpdatePhysicsBodies, const bool InMarkRenderStateDirty, bool bCreateInternalDataCopies, bool bPackedCustomData, const ETaskExecutionType& InExecutionType, UMultiTaskThreadPool* ThreadPool, UMultiTaskBase*& OutTask)
 		: FSingleTaskActionBase(InObject, LatentInfo, UUpdateInstancesTask::StaticClass())
 		, Branches(InBranches)
 		, bStarted(false)
@@ -111,6 +131,7 @@ public:
 			LocalTask->StartIndex = StartIndex;
 
 			LocalTask->bCreateInternalDataCopies = bCreateInternalDataCopies;
+			LocalTask->bPackedCustomData = bPackedCustomData;
 			LocalTask->TaskCount = TaskCount;
 
 			if (InstancesTransforms.Num() > 0)
@@ -177,10 +198,6 @@ public:
 									LocalTask->UpdatePhysicsBodies();
 								}
 								FMemory::Memcpy(&LocalTask->HISM->PerInstanceSMData[LocalTask->StartIndex], LocalTask->PerInstanceSMData.GetData(), sizeof(FInstancedStaticMeshInstanceData) * LocalTask->PerInstanceSMData.Num());
-								LocalTask->HISM->BuiltInstanceBounds += LocalTask->BuiltInstanceBounds;
-								LocalTask->HISM->UnbuiltInstanceBounds += LocalTask->UnbuiltInstanceBounds;
-								LocalTask->HISM->UnbuiltInstanceBoundsList.Append(LocalTask->UnbuiltInstanceBoundsList);
-
 							}
 
 
@@ -189,15 +206,18 @@ public:
 								FMemory::Memcpy(&LocalTask->HISM->PerInstanceSMCustomData[LocalTask->StartIndex * GetCustomDataSize(LocalTask->CustomDataType)], LocalTask->CustomDataPtr, LocalTask->CustomDataArraySize * sizeof(float));
 							}
 
-							if (LocalTask->Cmds.Num() > 0)
+							LocalTask->ApplyChunkResults();
+
+							const bool bRebuildCustomData = LocalTask->bPackedCustomData && LocalTask->CustomDataArraySize > 0;
+							if (bRebuildCustomData)
 							{
-								LocalTask->HISM->InstanceUpdateCmdBuffer.Cmds.Append(LocalTask->Cmds);
-								LocalTask->HISM->InstanceUpdateCmdBuffer.NumEdits += LocalTask->Cmds.Num();
+								// One edit for the whole block, the rebuilt tree reads Custom Data straight from PerInstanceSMCustomData.
+								LocalTask->HISM->InstanceUpdateCmdBuffer.NumEdits++;
 							}
 
-							if (LocalTask->UnbuiltInstanceBoundsList.Num() > 0)
+							if (LocalTask->UnbuiltInstancesNum > 0 || bRebuildCustomData)
 							{
-								LocalTask->HISM->BuildTreeIfOutdated(true, false);
+								LocalTask->HISM->BuildTreeIfOutdated(true, bRebuildCustomData);
 							}
 							else {
 								if (bMarkRenderStateDirty)
@@ -217,6 +237,7 @@ public:
 						LocalTask->PerInstanceSMData.Empty();
 						LocalTask->UnbuiltInstanceBoundsList.Empty();
 						LocalTask->Cmds.Empty();
+						LocalTask->ChunkResults.Empty();
 					}
 					Branches = EMultiTask2Branches::OnCompleted;
 					Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
@@ -235,6 +256,7 @@ public:
 					LocalTask->PerInstanceSMData.Empty();
 					LocalTask->UnbuiltInstanceBoundsList.Empty();
 					LocalTask->Cmds.Empty();
+					LocalTask->ChunkResults.Empty();
 				}
 				Branches = EMultiTask2Branches::OnCanceled;
 				Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
@@ -252,6 +274,7 @@ public:
 				LocalTask->PerInstanceSMData.Empty();
 				LocalTask->UnbuiltInstanceBoundsList.Empty();
 				LocalTask->Cmds.Empty();
+				LocalTask->ChunkResults.Empty();
 			}
 			//If we reached this point it means the task was unable to start.
 			Branches = EMultiTask2Branches::OnCompleted;